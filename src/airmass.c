@@ -18,7 +18,9 @@
  */
 
 #include <math.h>
+#include <stddef.h>
 #include <libnova/airmass.h>
+#include <libnova/sidereal_time.h>
 #include <libnova/utility.h>
 
 /*
@@ -46,3 +48,137 @@ double ln_get_alt_from_airmass (double X, double airmass_scale)
 {
 	return ln_rad_to_deg (asin ((2 * airmass_scale + 1 - X * X) / (2 * X * airmass_scale)));
 }
+
+/* replace sines of altitudes by airmasses, 0 below the horizon; the
+   formula is selected once and each has its own loop */
+static void get_airmass_sines (int model, double airmass_scale, double * X, int count)
+{
+	double s, a;
+	int i;
+
+	switch (model) {
+	case LN_AIRMASS_PLANE:
+		for (i = 0; i < count; i++) {
+			s = X[i];
+			X[i] = s > 0 ? 1.0 / s : 0;
+		}
+		break;
+	case LN_AIRMASS_YOUNG:
+		/* Young 1994, s is cosine of zenith distance */
+		for (i = 0; i < count; i++) {
+			s = X[i];
+			X[i] = s > 0 ? (1.002432 * s * s + 0.148386 * s + 0.0096467) /
+				(((s + 0.149864) * s + 0.0102963) * s + 0.000303978) : 0;
+		}
+		break;
+	case LN_AIRMASS_KASTEN_YOUNG:
+		/* Kasten & Young 1989, altitude in degrees */
+		for (i = 0; i < count; i++) {
+			s = X[i];
+			if (s > 0) {
+				a = ln_rad_to_deg (asin (s));
+				X[i] = 1.0 / (s + 0.50572 * pow (a + 6.07995, -1.6364));
+			} else {
+				X[i] = 0;
+			}
+		}
+		break;
+	default:
+		for (i = 0; i < count; i++) {
+			a = airmass_scale * X[i];
+			X[i] = a > 0 ? sqrt (a * a + 2 * airmass_scale + 1) - a : 0;
+		}
+		break;
+	}
+}
+
+/*! \fn void ln_get_airmass_batch (int model, double airmass_scale, double k, double * alt, int count, double * airmass, double * extinction)
+* \param model          Airmass formula, one of LN_AIRMASS_XXX
+* \param airmass_scale  Airmass scale of LN_AIRMASS_SCALE - usually 750.
+* \param k              Extinction coefficient in magnitudes per airmass
+* \param alt            Array of count altitudes in degrees
+* \param count          Number of altitudes
+* \param airmass        Array to store airmasses, or NULL
+* \param extinction     Array to store extinctions in magnitudes, or NULL
+*
+* Calculate airmass and extinction k * X for an array of altitudes.
+* Available formulas are plane-parallel atmosphere (secant of zenith
+* distance, only useful well above the horizon), Young (1994) for true
+* altitude, Kasten and Young (1989) for apparent altitude and the
+* homogeneous spherical atmosphere of ln_get_airmass. Below the horizon
+* airmass and extinction are 0.
+*/
+void ln_get_airmass_batch (int model, double airmass_scale, double k, double * alt, int count, double * airmass, double * extinction)
+{
+	double *X;
+	int i;
+
+	/* airmasses are computed in place of the first requested output */
+	X = airmass ? airmass : extinction;
+	if (X == NULL)
+		return;
+
+	for (i = 0; i < count; i++)
+		X[i] = sin (ln_deg_to_rad (alt[i]));
+	get_airmass_sines (model, airmass_scale, X, count);
+
+	if (extinction)
+		for (i = 0; i < count; i++)
+			extinction[i] = k * X[i];
+}
+
+/*! \fn void ln_get_airmass_grid (int model, double airmass_scale, double k, struct ln_equ_posn * objects, int n_objects, struct ln_lnlat_posn * observer, double JD_start, double JD_step, int n_JD, double * airmass, double * extinction)
+* \param model          Airmass formula, one of LN_AIRMASS_XXX
+* \param airmass_scale  Airmass scale of LN_AIRMASS_SCALE - usually 750.
+* \param k              Extinction coefficient in magnitudes per airmass
+* \param objects        Array of n_objects equatorial coordinates
+* \param n_objects      Number of objects
+* \param observer       Observer position
+* \param JD_start       Julian day of the first time
+* \param JD_step        Spacing of times in days
+* \param n_JD           Number of times
+* \param airmass        Array of n_objects * n_JD elements to store airmasses, or NULL
+* \param extinction     Array of n_objects * n_JD elements to store extinctions, or NULL
+*
+* Calculate airmass curves of many objects over a series of times, e.g.
+* for one night. Results of one object are consecutive,
+* airmass[object_index * n_JD + time_index]. Altitudes are the same as of
+* ln_get_hrz_from_equ, sines and cosines of declinations are calculated
+* once per object and sidereal time once for the series. Formulas and
+* values below the horizon are as in ln_get_airmass_batch.
+*/
+void ln_get_airmass_grid (int model, double airmass_scale, double k, struct ln_equ_posn * objects, int n_objects, struct ln_lnlat_posn * observer, double JD_start, double JD_step, int n_JD, double * airmass, double * extinction)
+{
+	double sidereal, sin_lat, cos_lat;
+	int i;
+
+	/* local mean sidereal time, its quadratic term is negligible over a night */
+	sidereal = ln_get_mean_sidereal_time (JD_start) * 15.0 + observer->lng;
+	sin_lat = sin (ln_deg_to_rad (observer->lat));
+	cos_lat = cos (ln_deg_to_rad (observer->lat));
+
+	if (airmass == NULL && extinction == NULL)
+		return;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (i = 0; i < n_objects; i++) {
+		double sin_dec, cos_dec, H, *X;
+		int j;
+
+		X = (airmass ? airmass : extinction) + i * n_JD;
+		sin_dec = sin_lat * sin (ln_deg_to_rad (objects[i].dec));
+		cos_dec = cos_lat * cos (ln_deg_to_rad (objects[i].dec));
+		H = sidereal - objects[i].ra;
+
+		for (j = 0; j < n_JD; j++)
+			X[j] = sin_dec + cos_dec *
+				cos (ln_deg_to_rad (H + j * JD_step * 360.98564736629));
+		get_airmass_sines (model, airmass_scale, X, n_JD);
+
+		if (extinction)
+			for (j = 0; j < n_JD; j++)
+				extinction[i * n_JD + j] = k * X[j];
+	}
+}
@@ -35,16 +35,17 @@ double ln_get_asteroid_mag (double JD, struct ln_ell_orbit * orbit, double H, do
 {
 	double t1,t2;
 	double b,r,d;
-	double E,M;
+	double E,M,n;
 	
 	/* get phase angle */
 	b = ln_get_ell_body_phase_angle (JD, orbit);
 	b = ln_deg_to_rad (b);
 	
 	/* get mean anomaly */
-	if (orbit->n == 0)
-		orbit->n = ln_get_ell_mean_motion (orbit->a);
-	M = ln_get_ell_mean_anomaly (orbit->n, JD - orbit->JD);
+	n = orbit->n;
+	if (n == 0)
+		n = ln_get_ell_mean_motion (orbit->a);
+	M = ln_get_ell_mean_anomaly (n, JD - orbit->JD);
 	
 	/* get eccentric anomaly */
 	E = ln_solve_kepler (orbit->e, M);
@@ -54,7 +55,7 @@ double ln_get_asteroid_mag (double JD, struct ln_ell_orbit * orbit, double H, do
 	d = ln_get_ell_body_solar_dist (JD, orbit);
 	
 	t1 = exp (-3.33 * pow (tan (b / 2.0), 0.63));
-	t2 = exp (-.187 * pow (tan (b / 2.0), 1.22));
+	t2 = exp (-1.87 * pow (tan (b / 2.0), 1.22));
 	
 	return H + 5 * log10 (r * d) - 2.5 * log10 ((1.0 - G) * t1 + G * t2);
 }
@@ -34,12 +34,13 @@
 double ln_get_ell_comet_mag (double JD, struct ln_ell_orbit * orbit, double g, double k)
 {
 	double d, r;
-	double E,M;
+	double E,M,n;
 	
 	/* get mean anomaly */
-	if (orbit->n == 0)
-		orbit->n = ln_get_ell_mean_motion (orbit->a);
-	M = ln_get_ell_mean_anomaly (orbit->n, JD - orbit->JD);
+	n = orbit->n;
+	if (n == 0)
+		n = ln_get_ell_mean_motion (orbit->a);
+	M = ln_get_ell_mean_anomaly (n, JD - orbit->JD);
 	
 	/* get eccentric anomaly */
 	E = ln_solve_kepler (orbit->e, M);
@@ -24,6 +24,8 @@
 #include <libnova/solar.h>
 #include <libnova/earth.h>
 #include <libnova/transform.h>
+#include <libnova/nutation.h>
+#include <libnova/sidereal_time.h>
 #include <libnova/rise_set.h>
 #include <libnova/utility.h>
 
@@ -2798,9 +2800,9 @@ void ln_get_earth_centre_dist (float height, double latitude, double *p_sin_o, d
      f = 1 / 298.257;
      b = a * (1 - f);
      
-     u = atan2(b, a * tan(ln_deg_to_rad(latitude)));
-     *p_sin_o = b / a * sin (u) + (height / 6378140 ) * sin (latitude);
-     *p_cos_o = cos (u) + (height / 6378140) * cos (latitude);
+     u = atan2(b * sin(ln_deg_to_rad(latitude)), a * cos(ln_deg_to_rad(latitude)));
+     *p_sin_o = b / a * sin (u) + (height / 6378140 ) * sin (ln_deg_to_rad (latitude));
+     *p_cos_o = cos (u) + (height / 6378140) * cos (ln_deg_to_rad (latitude));
 }
      
 /*! \fn void ln_get_earth_rect_helio (double JD, struct ln_rect_posn * position)
@@ -2817,3 +2819,94 @@ void ln_get_earth_rect_helio (double JD, struct ln_rect_posn * position)
 	ln_get_earth_helio_coords (JD, &earth);
 	ln_get_rect_from_helio (&earth, position);
 }
+
+/* Earth position and velocity from the VSOP87 series and their derivatives,
+ * optionally also the heliocentric ecliptical FK5 position */
+static void get_earth_state (double JD, struct ln_helio_posn * helio,
+	struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+{
+	double t;
+	double L[6], B[6], R[6];
+	double dL[6], dB[6], dR[6];
+	struct ln_helio_posn position, rate;
+
+	/* get julian ephemeris day */
+	t = (JD - 2451545.0) / 365250.0;
+
+	/* calc L series and derivatives */
+	L[0] = ln_calc_series_dot (earth_longitude_l0, LONG_L0, t, &dL[0]);
+	L[1] = ln_calc_series_dot (earth_longitude_l1, LONG_L1, t, &dL[1]);
+	L[2] = ln_calc_series_dot (earth_longitude_l2, LONG_L2, t, &dL[2]);
+	L[3] = ln_calc_series_dot (earth_longitude_l3, LONG_L3, t, &dL[3]);
+	L[4] = ln_calc_series_dot (earth_longitude_l4, LONG_L4, t, &dL[4]);
+	L[5] = ln_calc_series_dot (earth_longitude_l5, LONG_L5, t, &dL[5]);
+	position.L = ln_calc_series_poly (L, dL, 6, t, &rate.L);
+
+	/* calc B series and derivatives */
+	B[0] = ln_calc_series_dot (earth_latitude_b0, LAT_B0, t, &dB[0]);
+	B[1] = ln_calc_series_dot (earth_latitude_b1, LAT_B1, t, &dB[1]);
+	B[2] = ln_calc_series_dot (earth_latitude_b2, LAT_B2, t, &dB[2]);
+	B[3] = ln_calc_series_dot (earth_latitude_b3, LAT_B3, t, &dB[3]);
+	B[4] = ln_calc_series_dot (earth_latitude_b4, LAT_B4, t, &dB[4]);
+	B[5] = ln_calc_series_dot (earth_latitude_b5, LAT_B5, t, &dB[5]);
+	position.B = ln_calc_series_poly (B, dB, 6, t, &rate.B);
+
+	/* calc R series and derivatives */
+	R[0] = ln_calc_series_dot (earth_radius_r0, RADIUS_R0, t, &dR[0]);
+	R[1] = ln_calc_series_dot (earth_radius_r1, RADIUS_R1, t, &dR[1]);
+	R[2] = ln_calc_series_dot (earth_radius_r2, RADIUS_R2, t, &dR[2]);
+	R[3] = ln_calc_series_dot (earth_radius_r3, RADIUS_R3, t, &dR[3]);
+	R[4] = ln_calc_series_dot (earth_radius_r4, RADIUS_R4, t, &dR[4]);
+	R[5] = ln_calc_series_dot (earth_radius_r5, RADIUS_R5, t, &dR[5]);
+	position.R = ln_calc_series_poly (R, dR, 6, t, &rate.R);
+
+	/* change to degrees in correct quadrant, rates to degrees per day */
+	position.L = ln_range_degrees(ln_rad_to_deg(position.L));
+	position.B = ln_rad_to_deg(position.B) * -1.0;
+	rate.L = ln_rad_to_deg(rate.L) / 365250.0;
+	rate.B = ln_rad_to_deg(rate.B) * -1.0 / 365250.0;
+	rate.R /= 365250.0;
+
+	/* change to fk5 reference frame and rectangular coordinates */
+	ln_vsop87_rect_state (&position, &rate, JD, posn, vel);
+
+	if (helio) {
+		*helio = position;
+		ln_vsop87_to_fk5 (helio, JD);
+	}
+}
+
+/*! \fn void ln_get_earth_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \param JD Julian day.
+* \param posn pointer to return position
+* \param vel pointer to return velocity
+*
+* Calculate Earth rectangular heliocentric coordinates and velocity for the
+* given Julian day. Velocity is obtained by differentiating the VSOP87
+* series term by term. Coordinates are in AU, velocity in AU per day.
+*/
+void ln_get_earth_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+{
+	get_earth_state (JD, 0, posn, vel);
+}
+
+/*! \fn void ln_get_earth_state (double JD, struct ln_earth_state * state)
+* \param JD Julian day.
+* \param state pointer to return Earth state
+*
+* Calculate heliocentric position and velocity of the Earth, nutation,
+* obliquity of the ecliptic and apparent sidereal time for the given
+* Julian day. The VSOP87 series of the Earth are evaluated once. Pass the
+* state to ln_get_body_earth_state_equ_coords and
+* ln_get_solar_earth_state_equ_coords when many bodies are computed for
+* the same instant, and its sidereal time to
+* ln_get_hrz_from_equ_sidereal_time.
+*/
+void ln_get_earth_state (double JD, struct ln_earth_state * state)
+{
+	state->JD = JD;
+	get_earth_state (JD, &state->helio, &state->posn, &state->vel);
+	ln_get_nutation (JD, &state->nutation);
+	state->obliquity = state->nutation.ecliptic + state->nutation.obliquity;
+	state->sidereal = ln_get_apparent_sidereal_time (JD);
+}
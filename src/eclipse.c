@@ -0,0 +1,482 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <libnova/eclipse.h>
+#include <libnova/lunar.h>
+#include <libnova/solar.h>
+#include <libnova/earth.h>
+#include <libnova/utility.h>
+
+/* equatorial radius of the Earth in km */
+#define EARTH_RADIUS		6378.14
+
+/* mean synodic month */
+#define SYNODIC_MONTH		29.530588861
+
+/* precision of times of greatest eclipse and closest approach in days */
+#define ECLIPSE_PRECISION	1e-5
+#define ECLIPSE_MAX_ITER	30
+
+/* coarse lunar samples for occultations: one day in hourly steps */
+#define OCC_SAMPLES			24
+#define OCC_STEP			(1.0 / OCC_SAMPLES)
+
+/* Moon motion in one step and deviation of its path from a great
+   circle over one day, in degrees; both with a generous margin */
+#define OCC_STEP_MOTION		0.7
+#define OCC_PATH_MARGIN		0.5
+
+/* position of the body the Moon is compared with */
+struct sep_target
+{
+	int lunar;
+	struct ln_rect_posn star;
+	void (*get_equ_body_coords) (double, struct ln_equ_posn *);
+};
+
+static void get_unit_vector (struct ln_equ_posn *posn, struct ln_rect_posn *u)
+{
+	double ra = ln_deg_to_rad (posn->ra);
+	double dec = ln_deg_to_rad (posn->dec);
+
+	u->X = cos (dec) * cos (ra);
+	u->Y = cos (dec) * sin (ra);
+	u->Z = sin (dec);
+}
+
+static double get_dot (struct ln_rect_posn *a, struct ln_rect_posn *b)
+{
+	return a->X * b->X + a->Y * b->Y + a->Z * b->Z;
+}
+
+/* angle between unit vectors, in degrees */
+static double get_angle (struct ln_rect_posn *a, struct ln_rect_posn *b)
+{
+	double x = a->X - b->X;
+	double y = a->Y - b->Y;
+	double z = a->Z - b->Z;
+
+	return ln_rad_to_deg (2.0 * asin (sqrt (x * x + y * y + z * z) / 2.0));
+}
+
+/* squared chord between the Moon and the target, smooth near its minimum */
+static double get_chord2 (double JD, struct sep_target *target)
+{
+	struct ln_equ_posn moon, posn;
+	struct ln_rect_posn m, t;
+	double x, y, z;
+
+	ln_get_lunar_equ_coords (JD, &moon);
+	get_unit_vector (&moon, &m);
+
+	if (target->get_equ_body_coords) {
+		target->get_equ_body_coords (JD, &posn);
+		get_unit_vector (&posn, &t);
+	} else if (target->lunar >= 0) {
+		ln_get_solar_equ_coords (JD, &posn);
+		/* shadow axis points away from the Sun */
+		if (target->lunar) {
+			posn.ra += 180.0;
+			posn.dec = -posn.dec;
+		}
+		get_unit_vector (&posn, &t);
+	} else
+		t = target->star;
+
+	x = m.X - t.X;
+	y = m.Y - t.Y;
+	z = m.Z - t.Z;
+	return x * x + y * y + z * z;
+}
+
+/* find closest approach near JD by successive parabolic interpolation */
+static double get_closest_approach (struct sep_target *target, double JD,
+	double h, double *sep)
+{
+	double x[3], f[3], t, ft, d;
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		x[i] = JD + (i - 1) * h;
+		f[i] = get_chord2 (x[i], target);
+	}
+
+	/* move the bracket until the middle point is the lowest */
+	for (i = 0; i < ECLIPSE_MAX_ITER && (f[0] < f[1] || f[2] < f[1]); i++) {
+		if (f[0] < f[2]) {
+			x[2] = x[1]; f[2] = f[1];
+			x[1] = x[0]; f[1] = f[0];
+			x[0] -= h;
+			f[0] = get_chord2 (x[0], target);
+		} else {
+			x[0] = x[1]; f[0] = f[1];
+			x[1] = x[2]; f[1] = f[2];
+			x[2] += h;
+			f[2] = get_chord2 (x[2], target);
+		}
+	}
+
+	for (i = 0; i < ECLIPSE_MAX_ITER; i++) {
+		d = (x[1] - x[0]) * (f[1] - f[2]) - (x[1] - x[2]) * (f[1] - f[0]);
+		if (d == 0)
+			break;
+		t = x[1] - 0.5 * ((x[1] - x[0]) * (x[1] - x[0]) * (f[1] - f[2])
+			- (x[1] - x[2]) * (x[1] - x[2]) * (f[1] - f[0])) / d;
+		if (t <= x[0] || t >= x[2])
+			break;
+		if (fabs (t - x[1]) < ECLIPSE_PRECISION) {
+			ft = get_chord2 (t, target);
+			if (ft < f[1]) {
+				x[1] = t;
+				f[1] = ft;
+			}
+			break;
+		}
+
+		ft = get_chord2 (t, target);
+		if (t > x[1]) {
+			if (ft < f[1]) {
+				x[0] = x[1]; f[0] = f[1];
+				x[1] = t; f[1] = ft;
+			} else {
+				x[2] = t; f[2] = ft;
+			}
+		} else {
+			if (ft < f[1]) {
+				x[2] = x[1]; f[2] = f[1];
+				x[1] = t; f[1] = ft;
+			} else {
+				x[0] = t; f[0] = ft;
+			}
+		}
+	}
+
+	*sep = ln_rad_to_deg (2.0 * asin (sqrt (f[1]) / 2.0));
+	return x[1];
+}
+
+/* classify eclipse at greatest phase, returns 0 when there is none */
+static int get_eclipse_type (double JD, double sep, int lunar,
+	struct ln_eclipse *eclipse)
+{
+	double dist, R, pm, ps, sm, ss, ru, rp, gamma, smt;
+
+	dist = ln_get_lunar_earth_dist (JD);
+	R = ln_get_earth_solar_dist (JD);
+
+	/* parallaxes and semidiameters */
+	pm = ln_rad_to_deg (asin (EARTH_RADIUS / dist));
+	ps = 8.794 / 3600.0 / R;
+	sm = ln_get_lunar_sdiam (JD) / 3600.0;
+	ss = ln_get_solar_sdiam (JD) / 3600.0;
+
+	eclipse->JD = JD;
+	eclipse->separation = sep;
+
+	if (lunar) {
+		/* radii of umbra and penumbra, enlarged for the atmosphere */
+		ru = 1.02 * (0.99834 * pm - ss + ps);
+		rp = 1.02 * (0.99834 * pm + ss + ps);
+		if (sep >= rp + sm)
+			return 0;
+
+		eclipse->magnitude = (ru + sm - sep) / (2.0 * sm);
+		if (eclipse->magnitude <= 0) {
+			eclipse->type = LN_ECLIPSE_PENUMBRAL;
+			eclipse->magnitude = (rp + sm - sep) / (2.0 * sm);
+		} else if (sep <= ru - sm)
+			eclipse->type = LN_ECLIPSE_TOTAL;
+		else
+			eclipse->type = LN_ECLIPSE_PARTIAL;
+		return 1;
+	}
+
+	if (sep >= pm - ps + sm + ss)
+		return 0;
+
+	if (sep < pm - ps) {
+		/* shadow axis hits the Earth; compare discs seen from there */
+		gamma = sep / (pm - ps);
+		smt = sm * dist / (dist - EARTH_RADIUS * sqrt (1.0 - gamma * gamma));
+		eclipse->type = smt > ss ? LN_ECLIPSE_TOTAL : LN_ECLIPSE_ANNULAR;
+		eclipse->magnitude = smt / ss;
+	} else {
+		eclipse->type = LN_ECLIPSE_PARTIAL;
+		eclipse->magnitude = (pm - ps + sm + ss - sep) / (2.0 * ss);
+	}
+	return 1;
+}
+
+static int get_eclipses (double JD_start, double JD_end, int lunar,
+	struct ln_eclipse *eclipses, int max_eclipses)
+{
+	struct sep_target target;
+	struct ln_eclipse eclipse;
+	double k, T, F, JD, mean, sep;
+	int count = 0;
+
+	target.lunar = lunar;
+	target.get_equ_body_coords = 0;
+
+	k = floor ((JD_start - 2451550.09766) / SYNODIC_MONTH) - 1;
+	if (lunar)
+		k += 0.5;
+
+	for (;; k++) {
+		/* mean phase, Meeus equ 49.1 */
+		T = k / 1236.85;
+		mean = 2451550.09766 + SYNODIC_MONTH * k + 0.00015437 * T * T;
+		if (mean - 1.0 > JD_end)
+			break;
+
+		/* Moon's argument of latitude; no eclipse far from the node,
+		   Meeus chap 54 */
+		F = 160.7108 + 390.67050284 * k - 0.0016118 * T * T
+			- 0.00000227 * T * T * T;
+		if (fabs (sin (ln_deg_to_rad (F))) > 0.36)
+			continue;
+
+		/* true syzygy, then greatest eclipse on full precision positions */
+		JD = ln_get_lunar_next_phase (mean - 2.0,
+			lunar ? LN_LUNAR_FULL : LN_LUNAR_NEW);
+		JD = get_closest_approach (&target, JD, 0.05, &sep);
+		if (JD < JD_start || JD > JD_end)
+			continue;
+
+		if (!get_eclipse_type (JD, sep, lunar, &eclipse))
+			continue;
+
+		if (count < max_eclipses)
+			eclipses[count] = eclipse;
+		count++;
+	}
+
+	return count;
+}
+
+/*! \fn int ln_get_solar_eclipses (double JD_start, double JD_end, struct ln_eclipse * eclipses, int max_eclipses);
+* \param JD_start Start of the interval, Julian Day
+* \param JD_end End of the interval, Julian Day
+* \param eclipses Array of max_eclipses elements to store eclipses
+* \param max_eclipses Size of eclipses array
+* \return Number of eclipses found. If it is greater than max_eclipses,
+* only the first max_eclipses eclipses were stored.
+*
+* Find all solar eclipses visible from some place on the Earth in given
+* interval. Only new moons close enough to the lunar node are refined: the
+* syzygy is found with ln_get_lunar_next_phase and the greatest eclipse is
+* then the geocentric closest approach of the Moon to the Sun.
+*
+* Eclipses are classified as partial, annular or total. For central
+* eclipses magnitude is the ratio of lunar and solar apparent diameters
+* under the shadow axis; for partial eclipses it is the approximate
+* fraction of the solar diameter covered at the place of greatest eclipse.
+*/
+int ln_get_solar_eclipses (double JD_start, double JD_end,
+	struct ln_eclipse *eclipses, int max_eclipses)
+{
+	return get_eclipses (JD_start, JD_end, 0, eclipses, max_eclipses);
+}
+
+/*! \fn int ln_get_lunar_eclipses (double JD_start, double JD_end, struct ln_eclipse * eclipses, int max_eclipses);
+* \param JD_start Start of the interval, Julian Day
+* \param JD_end End of the interval, Julian Day
+* \param eclipses Array of max_eclipses elements to store eclipses
+* \param max_eclipses Size of eclipses array
+* \return Number of eclipses found. If it is greater than max_eclipses,
+* only the first max_eclipses eclipses were stored.
+*
+* Find all lunar eclipses in given interval, see ln_get_solar_eclipses.
+* Radii of the Earth's umbra and penumbra are enlarged by 2 per cent for
+* the atmosphere. Magnitude is the umbral magnitude, or the penumbral
+* magnitude for penumbral eclipses.
+*/
+int ln_get_lunar_eclipses (double JD_start, double JD_end,
+	struct ln_eclipse *eclipses, int max_eclipses)
+{
+	return get_eclipses (JD_start, JD_end, 1, eclipses, max_eclipses);
+}
+
+/* store occultation keeping the array sorted, returns new count */
+static int add_occultation (struct ln_occultation *occultations,
+	int max_occultations, int count, double JD, int index, double sep)
+{
+	int i;
+
+	if (count < max_occultations) {
+		for (i = count; i > 0 && occultations[i - 1].JD > JD; i--)
+			occultations[i] = occultations[i - 1];
+		occultations[i].JD = JD;
+		occultations[i].index = index;
+		occultations[i].separation = sep;
+	}
+	return count + 1;
+}
+
+/* coarse Moon samples for one day starting at JD, with one extra sample on
+   both sides; returns geocentric occultation limit in degrees */
+static double get_moon_samples (double JD, struct ln_rect_posn *moon)
+{
+	struct ln_equ_posn posn;
+	double dist;
+	int i;
+
+	for (i = 0; i < OCC_SAMPLES + 3; i++) {
+		ln_get_lunar_equ_coords_prec (JD + (i - 1) * OCC_STEP, &posn, 0.0001);
+		get_unit_vector (&posn, &moon[i]);
+	}
+
+	/* star is occulted somewhere on the Earth when closer than
+	   semidiameter plus horizontal parallax */
+	dist = ln_get_lunar_earth_dist (JD + 0.5);
+	return ln_get_lunar_sdiam (JD + 0.5) / 3600.0 +
+		ln_rad_to_deg (asin (EARTH_RADIUS / dist));
+}
+
+/*! \fn int ln_get_lunar_star_occultations (double JD_start, double JD_end, struct ln_equ_posn * stars, int n_stars, struct ln_occultation * occultations, int max_occultations);
+* \param JD_start Start of the interval, Julian Day
+* \param JD_end End of the interval, Julian Day
+* \param stars Array of n_stars star positions
+* \param n_stars Number of stars
+* \param occultations Array of max_occultations elements to store occultations
+* \param max_occultations Size of occultations array
+* \return Number of occultations found. If it is greater than
+* max_occultations, only the first max_occultations were stored.
+*
+* Find all occultations of given stars by the Moon visible from some place
+* on the Earth, i.e. all geocentric approaches closer than lunar
+* semidiameter plus horizontal parallax. Results are sorted by time.
+*
+* The Moon is sampled hourly at reduced precision. For each day, stars are
+* first checked against the band along the Moon's path with a single dot
+* product; only stars inside are compared with the hourly samples and the
+* closest approach is then refined with full precision lunar positions.
+* Checking a catalog of thousands of stars over a lunation is therefore
+* dominated by the lunar theory evaluations, not by the catalog size.
+*
+* Star positions should be referred to the same equinox as
+* ln_get_lunar_equ_coords (J2000) and include proper motion for the epoch.
+*/
+int ln_get_lunar_star_occultations (double JD_start, double JD_end,
+	struct ln_equ_posn *stars, int n_stars,
+	struct ln_occultation *occultations, int max_occultations)
+{
+	struct ln_rect_posn moon[OCC_SAMPLES + 3];
+	struct sep_target target;
+	double day, limit, band, dot, best, JD, sep;
+	int i, j, k, count = 0;
+
+	target.lunar = -1;
+	target.get_equ_body_coords = 0;
+
+	for (day = JD_start; day < JD_end; day += 1.0) {
+		limit = get_moon_samples (day, moon);
+
+		/* band around the path: half of the arc plus occultation limit */
+		band = cos (ln_deg_to_rad (get_angle (&moon[1], &moon[OCC_SAMPLES + 1])
+			/ 2.0 + limit + OCC_PATH_MARGIN));
+
+		for (i = 0; i < n_stars; i++) {
+			get_unit_vector (&stars[i], &target.star);
+			if (get_dot (&target.star, &moon[OCC_SAMPLES / 2 + 1]) < band)
+				continue;
+
+			/* nearest hourly sample */
+			best = -2;
+			k = 0;
+			for (j = 1; j <= OCC_SAMPLES + 1; j++) {
+				dot = get_dot (&target.star, &moon[j]);
+				if (dot > best) {
+					best = dot;
+					k = j;
+				}
+			}
+			if (get_angle (&target.star, &moon[k]) > limit + OCC_STEP_MOTION)
+				continue;
+
+			JD = get_closest_approach (&target, day + (k - 1) * OCC_STEP,
+				OCC_STEP / 2.0, &sep);
+
+			/* approaches near day boundary belong to one day only */
+			if (JD < day || JD >= day + 1.0 || JD < JD_start || JD > JD_end)
+				continue;
+			if (sep < limit)
+				count = add_occultation (occultations, max_occultations,
+					count, JD, i, sep);
+		}
+	}
+
+	return count;
+}
+
+/*! \fn int ln_get_lunar_body_occultations (double JD_start, double JD_end, void (*get_equ_body_coords) (double, struct ln_equ_posn *), struct ln_occultation * occultations, int max_occultations);
+* \param JD_start Start of the interval, Julian Day
+* \param JD_end End of the interval, Julian Day
+* \param get_equ_body_coords Pointer to get_equ_body_coords() function
+* \param occultations Array of max_occultations elements to store occultations
+* \param max_occultations Size of occultations array
+* \return Number of occultations found. If it is greater than
+* max_occultations, only the first max_occultations were stored.
+*
+* Find all occultations of a planet or other body by the Moon visible from
+* some place on the Earth, see ln_get_lunar_star_occultations. Index member
+* of found occultations is always 0.
+*/
+int ln_get_lunar_body_occultations (double JD_start, double JD_end,
+	void (*get_equ_body_coords) (double, struct ln_equ_posn *),
+	struct ln_occultation *occultations, int max_occultations)
+{
+	struct ln_rect_posn moon[OCC_SAMPLES + 3], body;
+	struct ln_equ_posn posn;
+	struct sep_target target;
+	double day, limit, angle, prev, next, JD, sep;
+	int j, count = 0;
+
+	target.lunar = -1;
+	target.get_equ_body_coords = get_equ_body_coords;
+
+	for (day = JD_start; day < JD_end; day += 1.0) {
+		limit = get_moon_samples (day, moon);
+
+		/* look for local minima of the separation at hourly samples */
+		get_equ_body_coords (day - OCC_STEP, &posn);
+		get_unit_vector (&posn, &body);
+		prev = get_angle (&body, &moon[0]);
+		get_equ_body_coords (day, &posn);
+		get_unit_vector (&posn, &body);
+		angle = get_angle (&body, &moon[1]);
+
+		for (j = 1; j <= OCC_SAMPLES + 1; j++) {
+			get_equ_body_coords (day + j * OCC_STEP, &posn);
+			get_unit_vector (&posn, &body);
+			next = get_angle (&body, &moon[j + 1]);
+
+			if (angle <= prev && angle < next && angle < limit + OCC_STEP_MOTION) {
+				JD = get_closest_approach (&target, day + (j - 1) * OCC_STEP,
+					OCC_STEP / 2.0, &sep);
+				if (JD >= day && JD < day + 1.0 && JD >= JD_start &&
+					JD <= JD_end && sep < limit)
+					count = add_occultation (occultations, max_occultations,
+						count, JD, 0, sep);
+			}
+			prev = angle;
+			angle = next;
+		}
+	}
+
+	return count;
+}
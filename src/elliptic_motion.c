@@ -18,9 +18,11 @@
 
 #include <math.h>
 #include <libnova/elliptic_motion.h>
+#include <libnova/orbit.h>
 #include <libnova/solar.h>
 #include <libnova/earth.h>
 #include <libnova/transform.h>
+#include <libnova/light_time.h>
 #include <libnova/rise_set.h>
 #include <libnova/dynamical_time.h>
 #include <libnova/sidereal_time.h>
@@ -30,6 +32,12 @@
 digit required */
 #define KEPLER_STEPS	53
 
+/* above this eccentricity the bisection is used */
+#define KEPLER_MAX_E	0.99
+
+/* Halley iterations after Markley starter; converged to double precision */
+#define KEPLER_ITER		2
+
 /* the BASIC SGN() function  for doubles */
 static double sgn (double x)
 {
@@ -42,48 +50,121 @@ static double sgn (double x)
 			return (1.0);
 }
 
+/* Roger Sinnott's bisection, M in <0, pi>, returns E in radians */
+static double solve_kepler_bisect (double e, double M)
+{
+	double Eo = M_PI_2;
+	double M1;
+	double D = M_PI_4;
+	int i;
+	
+	for (i = 0; i < KEPLER_STEPS; i++) {
+		M1 = Eo - e * sin (Eo);
+		Eo = Eo + D * sgn (M - M1);
+		D /= 2.0;
+	}
+	return Eo;
+}
+
+/* Markley starter (Celest. Mech. 63, 101, 1995) refined by Halley
+   iterations, M in <0, pi>, returns E in radians */
+static double solve_kepler_halley (double e, double M)
+{
+	double alpha, d, q, r, w, E, f, f1, f2, se;
+	int i;
+
+	alpha = (3.0 * M_PI * M_PI + 1.6 * M_PI * (M_PI - M) / (1.0 + e))
+		/ (M_PI * M_PI - 6.0);
+	d = 3.0 * (1.0 - e) + alpha * e;
+	q = 2.0 * alpha * d * (1.0 - e) - M * M;
+	r = 3.0 * alpha * d * (d - 1.0 + e) * M + M * M * M;
+	w = pow (fabs (r) + sqrt (q * q * q + r * r), 2.0 / 3.0);
+	E = (2.0 * r * w / (w * w + w * q + q * q) + M) / d;
+
+	for (i = 0; i < KEPLER_ITER; i++) {
+		se = e * sin (E);
+		f = E - se - M;
+		f1 = 1.0 - e * cos (E);
+		f2 = se;
+		E -= f / (f1 - 0.5 * f * f2 / f1);
+	}
+	return E;
+}
+
+/* reduce M in radians to <0, pi>, returns sign of E */
+static double reduce_mean_anomaly (double *M)
+{
+	double F;
+
+	F = sgn (*M); 
+	*M = fabs (*M) / (2.0 * M_PI);
+	*M = (*M - (int)*M) * 2.0 * M_PI * F;
+	
+	if (*M < 0)
+		*M = *M + 2.0 * M_PI;
+	F = 1.0;
+	
+	if (*M > M_PI) {
+		F = -1.0;
+		*M = 2.0 * M_PI - *M;
+	}
+	return F;
+}
+
 /*! \fn double ln_solve_kepler (double E, double M);
 * \param E Orbital eccentricity
 * \param M Mean anomaly
 * \return Eccentric anomaly
 *
 * Calculate the eccentric anomaly. 
-* This method was devised by Roger Sinnott. (Sky and Telescope, Vol 70, pg 159)
+* The starting value of Markley (Celestial Mechanics, Vol 63, pg 101) is
+* refined by two Halley iterations, which gives full double precision for
+* eccentricities up to 0.99. For more eccentric orbits the bisection method
+* devised by Roger Sinnott (Sky and Telescope, Vol 70, pg 159) is used.
 */
 double ln_solve_kepler (double e, double M)
 {
-	double Eo = M_PI_2;
-	double F, M1;
-	double D = M_PI_4;
-	int i;
+	double E, F;
 	
 	/* covert to radians */
 	M = ln_deg_to_rad (M);
+	F = reduce_mean_anomaly (&M);
 	
-	F = sgn (M); 
-	M = fabs (M) / (2.0 * M_PI);
-	M = (M - (int)M) * 2.0 * M_PI * F;
-	
-	if (M < 0)
-		M = M + 2.0 * M_PI;
-	F = 1.0;
-	
-	if (M > M_PI)
-		F = -1.0;
-	
-	if (M > M_PI)
-		M = 2.0 * M_PI - M;
-	
-	for (i = 0; i < KEPLER_STEPS; i++) {
-		M1 = Eo - e * sin (Eo);
-		Eo = Eo + D * sgn (M - M1);
-		D /= 2.0;
-	}
-	Eo *= F;
+	if (e > KEPLER_MAX_E)
+		E = solve_kepler_bisect (e, M);
+	else
+		E = solve_kepler_halley (e, M);
 	
 	/* back to degrees */
-	Eo = ln_rad_to_deg (Eo);
-	return Eo;
+	return ln_rad_to_deg (E * F);
+}
+
+/*! \fn void ln_solve_kepler_batch (double * e, double * M, double * E, int n);
+* \param e Array of n orbital eccentricities
+* \param M Array of n mean anomalies
+* \param E Array of n elements to store eccentric anomalies
+* \param n Number of elements
+*
+* Calculate eccentric anomalies for arrays of eccentricities and mean
+* anomalies with the same method, and the same results, as
+* ln_solve_kepler. Each element is solved only once: by Halley iterations
+* for eccentricities up to 0.99 and by bisection above. The loop calls
+* sin, cos and pow, so it is not vectorised by the compiler unless a
+* vector math library is used (e.g. glibc libmvec with -ffast-math).
+*/
+void ln_solve_kepler_batch (double *e, double *M, double *E, int n)
+{
+	double m, F;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		m = ln_deg_to_rad (M[i]);
+		F = reduce_mean_anomaly (&m);
+		if (e[i] > KEPLER_MAX_E)
+			E[i] = ln_rad_to_deg (F * solve_kepler_bisect (e[i], m));
+		else
+			E[i] = ln_rad_to_deg (F * solve_kepler_halley (e[i], m));
+	}
 }
 
 /*! \fn double ln_get_ell_mean_anomaly (double n, double delta_JD);
@@ -174,62 +255,32 @@ double ln_get_ell_mean_motion (double a)
 * \param posn Position pointer to store objects position
 *
 * Calculate the objects rectangular heliocentric position given it's orbital
-* elements for the given julian day. 
+* elements for the given julian day. When computing many positions on the
+* same orbit, use ln_prep_ell_orbit and ln_get_prep_helio_rect_posn.
 */
 void ln_get_ell_helio_rect_posn (struct ln_ell_orbit* orbit, double JD, struct ln_rect_posn* posn)
 {
-	double A,B,C;
-	double F,G,H;
-	double P,Q,R;
-	double sin_e, cos_e;
-	double a,b,c;
-	double sin_omega, sin_i, cos_omega, cos_i;
-	double M,v,E,r;
-	
-	/* J2000 obliquity of the ecliptic */
-	sin_e = 0.397777156;
-	cos_e = 0.917482062;
-	
-	/* equ 33.7 */
-	sin_omega = sin (ln_deg_to_rad (orbit->omega));
-	cos_omega = cos (ln_deg_to_rad (orbit->omega));
-	sin_i = sin (ln_deg_to_rad  (orbit->i));
-	cos_i = cos (ln_deg_to_rad  (orbit->i));
-	F = cos_omega;
-	G = sin_omega * cos_e;
-	H = sin_omega * sin_e;
-	P = -sin_omega * cos_i;
-	Q = cos_omega * cos_i * cos_e - sin_i * sin_e;
-	R = cos_omega * cos_i * sin_e + sin_i * cos_e;
-	
-	/* equ 33.8 */
-	A = atan2 (F,P);
-	B = atan2 (G,Q);
-	C = atan2 (H,R);
-	a = sqrt (F * F + P * P);
-	b = sqrt (G * G + Q * Q);
-	c = sqrt (H * H + R * R);
-
-	/* get daily motion */
-	if (orbit->n == 0) 
-			orbit->n = ln_get_ell_mean_motion (orbit->a);
+	struct ln_prep_orbit prep;
 
-	/* get mean anomaly */
-	M = ln_get_ell_mean_anomaly (orbit->n, JD - orbit->JD);
-
-	/* get eccentric anomaly */
-	E = ln_solve_kepler (orbit->e, M);
-
-	/* get true anomaly */
-	v = ln_get_ell_true_anomaly (orbit->e, E);
+	ln_prep_ell_orbit (orbit, &prep);
+	ln_get_prep_helio_rect_posn (&prep, JD, posn);
+}
 
-	/* get radius vector */
-	r = ln_get_ell_radius_vector (orbit->a, orbit->e, E);
+/*! \fn void ln_get_ell_helio_rect_state (struct ln_ell_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel);
+* \param orbit Orbital parameters of object.
+* \param JD Julian day
+* \param posn Position pointer to store objects position
+* \param vel Pointer to store objects velocity in AU per day
+*
+* Calculate the objects rectangular heliocentric position and velocity given
+* it's orbital elements for the given julian day.
+*/
+void ln_get_ell_helio_rect_state (struct ln_ell_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel)
+{
+	struct ln_prep_orbit prep;
 
-	/* equ 33.9 */
-	posn->X = r * a * sin (A + ln_deg_to_rad(orbit->w + v));
-	posn->Y = r * b * sin (B + ln_deg_to_rad(orbit->w + v));
-	posn->Z = r * c * sin (C + ln_deg_to_rad(orbit->w + v));
+	ln_prep_ell_orbit (orbit, &prep);
+	ln_get_prep_helio_rect_state (&prep, JD, posn, vel);
 }
 
 /*! \fn void ln_get_ell_geo_rect_posn (struct ln_ell_orbit* orbit, double JD, struct ln_rect_posn* posn);
@@ -268,28 +319,16 @@ void ln_get_ell_geo_rect_posn (struct ln_ell_orbit* orbit, double JD, struct ln_
 */
 void ln_get_ell_body_equ_coords (double JD, struct ln_ell_orbit * orbit, struct ln_equ_posn * posn)
 {
-	struct ln_rect_posn body_rect_posn, sol_rect_posn;
-	double dist, t;
-	double x,y,z;
-	
-	/* get solar and body rect coords */
-	ln_get_ell_helio_rect_posn (orbit, JD, &body_rect_posn);
-	ln_get_solar_geo_coords (JD, &sol_rect_posn);
-	
-	/* calc distance and light time */
-	dist = ln_get_rect_distance (&body_rect_posn, &sol_rect_posn);
-	t = ln_get_light_time (dist);
+	struct ln_rect_posn body_rect_posn, body_vel, earth_rect_posn, geo_rect_posn;
 
-	/* repeat calculation with new time (i.e. JD - t) */
-	ln_get_ell_helio_rect_posn (orbit, JD - t, &body_rect_posn);
-	
-	/* calc equ coords equ 33.10 */
-	x = sol_rect_posn.X + body_rect_posn.X;
-	y = sol_rect_posn.Y + body_rect_posn.Y;
-	z = sol_rect_posn.Z + body_rect_posn.Z;
+	/* get earth and body rect coords */
+	ln_get_ell_helio_rect_state (orbit, JD, &body_rect_posn, &body_vel);
+	ln_get_earth_rect_helio (JD, &earth_rect_posn);
 
-	posn->ra = ln_range_degrees(ln_rad_to_deg(atan2 (y,x)));
-	posn->dec = ln_rad_to_deg(asin (z / sqrt (x * x + y * y + z * z)));
+	/* correct for light time and calc equ coords equ 33.10 */
+	ln_get_light_time_geo_posn (&earth_rect_posn, &body_rect_posn, &body_vel,
+		&geo_rect_posn);
+	ln_get_equ_from_rect (&geo_rect_posn, posn);
 }
 
 
@@ -423,13 +462,14 @@ double ln_get_ell_body_earth_dist (double JD, struct ln_ell_orbit * orbit)
 double ln_get_ell_body_phase_angle (double JD, struct ln_ell_orbit * orbit)
 {
 	double r,R,d;
-	double E,M;
+	double E,M,n;
 	double phase;
 	
 	/* get mean anomaly */
-	if (orbit->n == 0)
-		orbit->n = ln_get_ell_mean_motion (orbit->a);
-	M = ln_get_ell_mean_anomaly (orbit->n, JD - orbit->JD);
+	n = orbit->n;
+	if (n == 0)
+		n = ln_get_ell_mean_motion (orbit->a);
+	M = ln_get_ell_mean_anomaly (n, JD - orbit->JD);
 	
 	/* get eccentric anomaly */
 	E = ln_solve_kepler (orbit->e, M);
@@ -458,15 +498,16 @@ double ln_get_ell_body_elong (double JD, struct ln_ell_orbit * orbit)
 	double r,R,d;
 	double t;
 	double elong;
-	double E,M;
+	double E,M,n;
 	
 	/* time since perihelion */
 	t = JD - orbit->JD;
 	
 	/* get mean anomaly */
-	if (orbit->n == 0)
-		orbit->n = ln_get_ell_mean_motion (orbit->a);
-	M = ln_get_ell_mean_anomaly (orbit->n, t);
+	n = orbit->n;
+	if (n == 0)
+		n = ln_get_ell_mean_motion (orbit->a);
+	M = ln_get_ell_mean_anomaly (n, t);
 	
 	/* get eccentric anomaly */
 	E = ln_solve_kepler (orbit->e, M);
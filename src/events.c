@@ -0,0 +1,341 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <libnova/events.h>
+#include <libnova/airmass.h>
+#include <libnova/solar.h>
+#include <libnova/sidereal_time.h>
+#include <libnova/dynamical_time.h>
+#include <libnova/utility.h>
+
+/* refinement precision in days (~0.01s) and iteration limit */
+#define EVENT_PRECISION		1e-7
+#define EVENT_MAX_ITER		60
+
+/* sidereal rate in degrees per solar day */
+#define SIDEREAL_RATE		360.98564736629
+
+/* one coarse sample of the body position */
+struct hrz_sample
+{
+	double JD;
+	double ra;
+	double dec;
+	double theta;
+};
+
+/* state of one sweep */
+struct hrz_search
+{
+	struct hrz_sample s[3];
+	struct ln_lnlat_posn *observer;
+	double step;
+	double *thresholds;
+	double airmass_scale;
+	double sin_lat;
+	double cos_lat;
+};
+
+static void get_sample (double JD, double dT,
+	void (*get_equ_body_coords) (double, struct ln_equ_posn *),
+	struct ln_equ_posn *object, struct hrz_sample *s)
+{
+	struct ln_equ_posn pos;
+
+	if (get_equ_body_coords)
+		get_equ_body_coords (JD + dT, &pos);
+	else
+		pos = *object;
+
+	s->JD = JD;
+	s->ra = pos.ra;
+	s->dec = pos.dec;
+	s->theta = ln_get_apparent_sidereal_time (JD) * 15.0;
+}
+
+/* returns threshold altitude j, or sin of hour angle for j < 0 */
+static double get_event_value (struct hrz_search *ctx, double JD, int j)
+{
+	double n, ra0, ra2, ra, dec, H, alt, h;
+
+	/* interpolate position between samples 1 and 2 of the window */
+	n = (JD - ctx->s[1].JD) / ctx->step;
+
+	ra0 = ctx->s[0].ra;
+	ra2 = ctx->s[2].ra;
+	if (ra0 - ctx->s[1].ra > 180.0)
+		ra0 -= 360.0;
+	else if (ra0 - ctx->s[1].ra < -180.0)
+		ra0 += 360.0;
+	if (ra2 - ctx->s[1].ra > 180.0)
+		ra2 -= 360.0;
+	else if (ra2 - ctx->s[1].ra < -180.0)
+		ra2 += 360.0;
+
+	ra = ln_interpolate3 (n, ra0, ctx->s[1].ra, ra2);
+	dec = ln_interpolate3 (n, ctx->s[0].dec, ctx->s[1].dec, ctx->s[2].dec);
+
+	H = ln_deg_to_rad (ctx->s[1].theta + SIDEREAL_RATE * (JD - ctx->s[1].JD)
+		+ ctx->observer->lng - ra);
+	if (j < 0)
+		return sin (H);
+
+	dec = ln_deg_to_rad (dec);
+	alt = ln_rad_to_deg (asin (ctx->sin_lat * sin (dec) +
+		ctx->cos_lat * cos (dec) * cos (H)));
+
+	if (ctx->airmass_scale > 0)
+		h = ln_get_alt_from_airmass (ctx->thresholds[j], ctx->airmass_scale);
+	else
+		h = ctx->thresholds[j];
+
+	return alt - h;
+}
+
+/* Illinois variant of regula falsi on bracket a, b */
+static double refine_event (struct hrz_search *ctx, int j,
+	double a, double fa, double b, double fb)
+{
+	double c, fc;
+	int i, side = 0;
+
+	c = (a * fb - b * fa) / (fb - fa);
+	for (i = 0; i < EVENT_MAX_ITER && fabs (b - a) > EVENT_PRECISION; i++) {
+		fc = get_event_value (ctx, c, j);
+		if (fc == 0)
+			break;
+		if (fc * fb > 0) {
+			b = c;
+			fb = fc;
+			if (side == -1)
+				fa /= 2.0;
+			side = -1;
+		} else {
+			a = c;
+			fa = fc;
+			if (side == 1)
+				fb /= 2.0;
+			side = 1;
+		}
+		c = (a * fb - b * fa) / (fb - fa);
+	}
+	return c;
+}
+
+/* store event keeping the array sorted, returns new event count; events
+   refined out of time order may be earlier than the last one stored, so
+   with the array full an earlier event replaces the latest stored one */
+static int add_event (struct ln_hrz_event *events, int max_events, int count,
+	double JD, int type, int threshold)
+{
+	int i;
+
+	i = count;
+	if (count >= max_events) {
+		if (max_events < 1 || events[max_events - 1].JD <= JD)
+			return count + 1;
+		i = max_events - 1;
+	}
+
+	for (; i > 0 && events[i - 1].JD > JD; i--)
+		events[i] = events[i - 1];
+	events[i].JD = JD;
+	events[i].type = type;
+	events[i].threshold = threshold;
+
+	return count + 1;
+}
+
+static int get_hrz_events (double JD_start, double JD_end,
+	struct ln_lnlat_posn *observer,
+	void (*get_equ_body_coords) (double, struct ln_equ_posn *),
+	struct ln_equ_posn *object, double step, double *thresholds,
+	int n_thresholds, double airmass_scale, int transits,
+	struct ln_hrz_event *events, int max_events)
+{
+	struct hrz_search ctx;
+	double dT, a, b, fa, fb, JD;
+	int i, j, steps, count = 0;
+
+	if (JD_end <= JD_start)
+		return 0;
+	if (step <= 0)
+		step = LN_EVENT_DEFAULT_STEP;
+
+	/* body positions are requested in dynamical time */
+	dT = ln_get_dynamical_time_diff (JD_start) / 86400.0;
+
+	ctx.observer = observer;
+	ctx.step = step;
+	ctx.thresholds = thresholds;
+	ctx.airmass_scale = airmass_scale;
+	ctx.sin_lat = sin (ln_deg_to_rad (observer->lat));
+	ctx.cos_lat = cos (ln_deg_to_rad (observer->lat));
+
+	steps = (int) ceil ((JD_end - JD_start) / step);
+
+	get_sample (JD_start - step, dT, get_equ_body_coords, object, &ctx.s[1]);
+	get_sample (JD_start, dT, get_equ_body_coords, object, &ctx.s[2]);
+
+	for (i = 1; i <= steps; i++) {
+		ctx.s[0] = ctx.s[1];
+		ctx.s[1] = ctx.s[2];
+		get_sample (JD_start + i * step, dT, get_equ_body_coords, object,
+			&ctx.s[2]);
+
+		a = ctx.s[1].JD;
+		b = ctx.s[2].JD;
+
+		/* j == -1 is the meridian passage */
+		for (j = transits ? -1 : 0; j < n_thresholds; j++) {
+			fa = get_event_value (&ctx, a, j);
+			fb = get_event_value (&ctx, b, j);
+
+			if ((fa < 0) == (fb < 0))
+				continue;
+
+			JD = refine_event (&ctx, j, a, fa, b, fb);
+			if (JD < JD_start || JD > JD_end)
+				continue;
+
+			if (j < 0)
+				count = add_event (events, max_events, count, JD,
+					fa < 0 ? LN_EVENT_UPPER_TRANSIT : LN_EVENT_LOWER_TRANSIT, -1);
+			else
+				count = add_event (events, max_events, count, JD,
+					fa < 0 ? LN_EVENT_RISE : LN_EVENT_SET, j);
+		}
+	}
+
+	return count;
+}
+
+/*! \fn int ln_get_body_hrz_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double step, double * thresholds, int n_thresholds, int transits, struct ln_hrz_event * events, int max_events);
+* \param JD_start Start of the searched interval, JD (UT)
+* \param JD_end End of the searched interval, JD (UT)
+* \param observer Observers position
+* \param get_equ_body_coords Pointer to get_equ_body_coords() function
+* \param step Sampling step in days, 0 for LN_EVENT_DEFAULT_STEP
+* \param thresholds Array of n_thresholds altitudes in degrees
+* \param n_thresholds Number of thresholds
+* \param transits When non zero, report upper and lower meridian passages
+* \param events Array of max_events elements to store events
+* \param max_events Size of events array
+* \return Number of events found. If it is greater than max_events, only
+* the first max_events events were stored.
+*
+* Find all times in interval JD_start to JD_end at which the body crosses
+* any of the given altitudes, and optionally the times it passes the local
+* meridian. The body is sampled once every step days and each sign change
+* is then refined on the interpolated positions to about 0.01 second, so
+* the whole window is searched in one sweep regardless of the number of
+* thresholds. Events are returned sorted by time; rise means the altitude
+* is increasing at the crossing. The threshold member holds the index of
+* the crossed altitude in thresholds array.
+*
+* Note: the step must be short enough that the body crosses each threshold
+* at most once between samples. The default of one hour is safe for the
+* Sun, the Moon and the planets.
+*/
+int ln_get_body_hrz_events (double JD_start, double JD_end,
+	struct ln_lnlat_posn *observer,
+	void (*get_equ_body_coords) (double, struct ln_equ_posn *), double step,
+	double *thresholds, int n_thresholds, int transits,
+	struct ln_hrz_event *events, int max_events)
+{
+	return get_hrz_events (JD_start, JD_end, observer, get_equ_body_coords,
+		NULL, step, thresholds, n_thresholds, 0, transits, events, max_events);
+}
+
+/*! \fn int ln_get_body_airmass_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double step, double * airmasses, int n_airmasses, double airmass_scale, struct ln_hrz_event * events, int max_events);
+* \param JD_start Start of the searched interval, JD (UT)
+* \param JD_end End of the searched interval, JD (UT)
+* \param observer Observers position
+* \param get_equ_body_coords Pointer to get_equ_body_coords() function
+* \param step Sampling step in days, 0 for LN_EVENT_DEFAULT_STEP
+* \param airmasses Array of n_airmasses airmass values
+* \param n_airmasses Number of airmass values
+* \param airmass_scale Airmass scale - usually 750.
+* \return Number of events found, see ln_get_body_hrz_events.
+*
+* Find all times in interval JD_start to JD_end at which the body crosses
+* any of the given airmasses, as computed by ln_get_airmass. Rise means the
+* body is getting higher, i.e. airmass is decreasing.
+*/
+int ln_get_body_airmass_events (double JD_start, double JD_end,
+	struct ln_lnlat_posn *observer,
+	void (*get_equ_body_coords) (double, struct ln_equ_posn *), double step,
+	double *airmasses, int n_airmasses, double airmass_scale,
+	struct ln_hrz_event *events, int max_events)
+{
+	return get_hrz_events (JD_start, JD_end, observer, get_equ_body_coords,
+		NULL, step, airmasses, n_airmasses, airmass_scale, 0, events,
+		max_events);
+}
+
+/*! \fn int ln_get_object_hrz_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, struct ln_equ_posn * object, double * thresholds, int n_thresholds, int transits, struct ln_hrz_event * events, int max_events);
+* \param JD_start Start of the searched interval, JD (UT)
+* \param JD_end End of the searched interval, JD (UT)
+* \param observer Observers position
+* \param object Object position
+* \param thresholds Array of n_thresholds altitudes in degrees
+* \param n_thresholds Number of thresholds
+* \param transits When non zero, report upper and lower meridian passages
+* \param events Array of max_events elements to store events
+* \param max_events Size of events array
+* \return Number of events found, see ln_get_body_hrz_events.
+*
+* Find all altitude crossings and meridian passages of a fixed object, e.g.
+* to find times a target is above given altitude during a night.
+*/
+int ln_get_object_hrz_events (double JD_start, double JD_end,
+	struct ln_lnlat_posn *observer, struct ln_equ_posn *object,
+	double *thresholds, int n_thresholds, int transits,
+	struct ln_hrz_event *events, int max_events)
+{
+	return get_hrz_events (JD_start, JD_end, observer, NULL, object,
+		LN_EVENT_DEFAULT_STEP, thresholds, n_thresholds, 0, transits, events,
+		max_events);
+}
+
+/*! \fn int ln_get_solar_twilight_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, struct ln_hrz_event * events, int max_events);
+* \param JD_start Start of the searched interval, JD (UT)
+* \param JD_end End of the searched interval, JD (UT)
+* \param observer Observers position
+* \param events Array of max_events elements to store events
+* \param max_events Size of events array
+* \return Number of events found, see ln_get_body_hrz_events.
+*
+* Find sunrise and sunset and start and end of civil, nautical and
+* astronomical twilight in a single sweep. Threshold index 0 is the standard
+* solar horizon, 1 civil, 2 nautical and 3 astronomical twilight.
+*/
+int ln_get_solar_twilight_events (double JD_start, double JD_end,
+	struct ln_lnlat_posn *observer, struct ln_hrz_event *events,
+	int max_events)
+{
+	double thresholds[4] = {
+		LN_SOLAR_STANDART_HORIZON,
+		LN_SOLAR_CIVIL_HORIZON,
+		LN_SOLAR_NAUTIC_HORIZON,
+		LN_SOLAR_ASTRONOMICAL_HORIZON
+	};
+
+	return get_hrz_events (JD_start, JD_end, observer, ln_get_solar_equ_coords,
+		NULL, LN_EVENT_DEFAULT_STEP, thresholds, 4, 0, 0, events, max_events);
+}
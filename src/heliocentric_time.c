@@ -19,6 +19,7 @@
 #include <libnova/heliocentric_time.h>
 #include <libnova/nutation.h>
 #include <libnova/earth.h>
+#include <libnova/nbody.h>
 #include <libnova/utility.h>
 
 #include <math.h>
@@ -53,3 +54,115 @@ double ln_get_heliocentric_time_diff (double JD, struct ln_equ_posn *object)
 		cos (theta) * cos (ra) * c_dec
 		+ sin (theta) * (sin (obliq) * sin (dec) + cos (obliq) * c_dec * sin (ra)));
 }
+
+#define GAUS_GRAV	0.01720209895	// Gaussian gravitational constant k
+
+/* speed of light in AU per day */
+#define C_LIGHT		173.1446326846693
+
+/* index of the Earth in planet cache */
+#define EARTH		2
+
+/*! \fn double ln_get_tdb_tt_diff (double JD)
+* \param JD Julian day in TT
+* \return TDB - TT in seconds
+*
+* Calculate difference of Barycentric Dynamical Time and Terrestrial Time
+* by the approximation of Fairhead and Bretagnon, accurate to about 10
+* microseconds between 1600 and 2200.
+*/
+/* USNO Circular 179, equ 2.6 */
+double ln_get_tdb_tt_diff (double JD)
+{
+	double T;
+
+	T = (JD - 2451545.0) / 36525.0;
+
+	return 0.001657 * sin (628.3076 * T + 6.2401)
+		+ 0.000022 * sin (575.3385 * T + 4.2970)
+		+ 0.000014 * sin (1256.6152 * T + 6.1969)
+		+ 0.000005 * sin (606.9777 * T + 4.0212)
+		+ 0.000005 * sin (52.9691 * T + 0.4444)
+		+ 0.000002 * sin (21.3299 * T + 5.5431)
+		+ 0.000010 * T * sin (628.3076 * T + 4.2490);
+}
+
+/*! \fn int ln_get_helio_time_diff_batch (struct ln_nbody_cache * cache, int mode, double * JD, double * ra, double * dec, int count, double * diff)
+* \param cache Planet cache from ln_prep_nbody_cache covering all times
+* \param mode LN_HELIO_TIME_HJD or LN_HELIO_TIME_BJD_TDB
+* \param JD Array of count Julian days in TT
+* \param ra Array of count J2000 right ascensions in degrees
+* \param dec Array of count J2000 declinations in degrees
+* \param count Number of times
+* \param diff Array of count elements to store corrections in days
+* \return Number of times not covered by cache
+*
+* Calculate heliocentric or barycentric time corrections for arrays of
+* times and object positions, e.g. photometric measurements of many stars
+* during a night. Positions of the Earth and, for barycentric corrections,
+* the planets are interpolated from the cache of ln_prep_nbody_cache,
+* where one node per day is sufficient for microsecond accuracy.
+*
+* LN_HELIO_TIME_HJD gives the light travel time from the Earth to the
+* Sun's centre projected on the object direction, HJD = JD + diff.
+*
+* LN_HELIO_TIME_BJD_TDB refers the time to the barycentre of the solar
+* system, which is offset from the Sun by the planets with GM of the
+* cache, and adds TDB - TT, so BJD_TDB = JD_TT + diff. Shapiro delay and
+* the Einstein delay of the observer's position on the Earth are ignored.
+*
+* Times outside the cache would extrapolate the interpolating polynomial,
+* so they are rejected and NaN is stored as their correction.
+*/
+int ln_get_helio_time_diff_batch (struct ln_nbody_cache * cache, int mode, double * JD, double * ra, double * dec, int count, double * diff)
+{
+	double JD_end;
+	int i, failed = 0;
+
+	JD_end = cache->JD + (cache->nodes - 1) * cache->step;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:failed)
+#endif
+	for (i = 0; i < count; i++) {
+		struct ln_rect_posn planets[LN_NBODY_PLANETS], earth;
+		double ra_rad, dec_rad, c_dec, GM;
+		int j;
+
+		if (JD[i] < cache->JD || JD[i] > JD_end) {
+			diff[i] = nan ("0");
+			failed++;
+			continue;
+		}
+
+		ln_get_nbody_cache_planets (cache, JD[i], planets);
+		earth = planets[EARTH];
+
+		if (mode == LN_HELIO_TIME_BJD_TDB) {
+			/* barycentre of the solar system relative to the Sun */
+			struct ln_rect_posn bary = {0, 0, 0};
+			GM = GAUS_GRAV * GAUS_GRAV;
+			for (j = 0; j < LN_NBODY_PLANETS; j++) {
+				bary.X += cache->GM[j] * planets[j].X;
+				bary.Y += cache->GM[j] * planets[j].Y;
+				bary.Z += cache->GM[j] * planets[j].Z;
+				GM += cache->GM[j];
+			}
+			earth.X -= bary.X / GM;
+			earth.Y -= bary.Y / GM;
+			earth.Z -= bary.Z / GM;
+		}
+
+		ra_rad = ln_deg_to_rad (ra[i]);
+		dec_rad = ln_deg_to_rad (dec[i]);
+		c_dec = cos (dec_rad);
+
+		diff[i] = (earth.X * cos (ra_rad) * c_dec + earth.Y * sin (ra_rad) * c_dec
+			+ earth.Z * sin (dec_rad)) / C_LIGHT;
+
+		if (mode == LN_HELIO_TIME_BJD_TDB)
+			diff[i] += ln_get_tdb_tt_diff (JD[i]) / 86400.0;
+	}
+
+	return failed;
+}
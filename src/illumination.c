@@ -0,0 +1,256 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+
+#include <math.h>
+#include <libnova/illumination.h>
+#include <libnova/solar.h>
+#include <libnova/lunar.h>
+#include <libnova/sidereal_time.h>
+#include <libnova/utility.h>
+
+/* columns of a grid sharing one block of hour angle terms */
+#define GRID_CHUNK		64
+
+/*! \fn void ln_get_body_subpoint (double JD, struct ln_equ_posn * object, struct ln_lnlat_posn * subpoint)
+* \param JD Julian day
+* \param object Equatorial coordinates of object
+* \param subpoint Pointer to store geographic position
+*
+* Calculate the geographic position where the object is in the zenith.
+* Longitude is positive east, in the range -180 to 180 degrees. Mean
+* sidereal time is used, as in ln_get_hrz_from_equ.
+*/
+void ln_get_body_subpoint (double JD, struct ln_equ_posn * object, struct ln_lnlat_posn * subpoint)
+{
+	double lng;
+
+	lng = ln_range_degrees (object->ra - ln_get_mean_sidereal_time (JD) * 15.0);
+	if (lng > 180.0)
+		lng -= 360.0;
+
+	subpoint->lng = lng;
+	subpoint->lat = object->dec;
+}
+
+/*! \fn void ln_get_solar_subpoint (double JD, struct ln_lnlat_posn * subpoint)
+* \param JD Julian day
+* \param subpoint Pointer to store geographic position
+*
+* Calculate the sub-solar point, where the Sun is in the zenith.
+*/
+void ln_get_solar_subpoint (double JD, struct ln_lnlat_posn * subpoint)
+{
+	struct ln_equ_posn equ;
+
+	ln_get_solar_equ_coords (JD, &equ);
+	ln_get_body_subpoint (JD, &equ, subpoint);
+}
+
+/*! \fn void ln_get_lunar_subpoint (double JD, struct ln_lnlat_posn * subpoint)
+* \param JD Julian day
+* \param subpoint Pointer to store geographic position
+*
+* Calculate the sub-lunar point, where the Moon is in the geocentric
+* zenith. Parallax is not taken into account.
+*/
+void ln_get_lunar_subpoint (double JD, struct ln_lnlat_posn * subpoint)
+{
+	struct ln_equ_posn equ;
+
+	ln_get_lunar_equ_coords (JD, &equ);
+	ln_get_body_subpoint (JD, &equ, subpoint);
+}
+
+/* classify solar altitude */
+static unsigned char get_illum (double alt)
+{
+	if (alt >= LN_SOLAR_STANDART_HORIZON)
+		return LN_ILLUM_DAY;
+	if (alt >= LN_SOLAR_CIVIL_HORIZON)
+		return LN_ILLUM_CIVIL;
+	if (alt >= LN_SOLAR_NAUTIC_HORIZON)
+		return LN_ILLUM_NAUTIC;
+	if (alt >= LN_SOLAR_ASTRONOMICAL_HORIZON)
+		return LN_ILLUM_ASTRONOMICAL;
+	return LN_ILLUM_NIGHT;
+}
+
+/* altitudes or illumination classes of grid points */
+static void get_grid (double JD, struct ln_equ_posn * object,
+	struct ln_lnlat_grid * grid, double * alt, unsigned char * illum)
+{
+	double sidereal, sin_dec, cos_dec;
+	int i;
+
+	sidereal = ln_get_mean_sidereal_time (JD) * 15.0;
+	sin_dec = sin (ln_deg_to_rad (object->dec));
+	cos_dec = cos (ln_deg_to_rad (object->dec));
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for (i = 0; i < grid->n_lng; i += GRID_CHUNK) {
+		double cos_H[GRID_CHUNK], lat, sin_lat, cos_lat, h;
+		int j, k, count;
+
+		count = grid->n_lng - i;
+		if (count > GRID_CHUNK)
+			count = GRID_CHUNK;
+
+		/* hour angle terms once per column */
+		for (k = 0; k < count; k++)
+			cos_H[k] = cos_dec * cos (ln_deg_to_rad (sidereal +
+				grid->lng_start + (i + k) * grid->lng_step - object->ra));
+
+		/* latitude terms once per row */
+		for (j = 0; j < grid->n_lat; j++) {
+			lat = ln_deg_to_rad (grid->lat_start + j * grid->lat_step);
+			sin_lat = sin (lat) * sin_dec;
+			cos_lat = cos (lat);
+			for (k = 0; k < count; k++) {
+				h = ln_rad_to_deg (asin (sin_lat + cos_lat * cos_H[k]));
+				if (alt)
+					alt[j * grid->n_lng + i + k] = h;
+				if (illum)
+					illum[j * grid->n_lng + i + k] = get_illum (h);
+			}
+		}
+	}
+}
+
+/*! \fn void ln_get_body_alt_grid (double JD, struct ln_equ_posn * object, struct ln_lnlat_grid * grid, double * alt)
+* \param JD Julian day
+* \param object Equatorial coordinates of object
+* \param grid Grid of geographic positions
+* \param alt Array of grid->n_lat * grid->n_lng elements to store altitudes
+*
+* Calculate altitude of an object above the horizon of all points of a
+* longitude/latitude grid. Altitudes are stored by rows of equal latitude,
+* alt[lat_index * grid->n_lng + lng_index]. Sines and cosines of hour
+* angles and latitudes are calculated once per column and row. Altitudes
+* are the same as of ln_get_hrz_from_equ, without refraction.
+*/
+void ln_get_body_alt_grid (double JD, struct ln_equ_posn * object, struct ln_lnlat_grid * grid, double * alt)
+{
+	get_grid (JD, object, grid, alt, 0);
+}
+
+/*! \fn void ln_get_solar_alt_grid (double JD, struct ln_lnlat_grid * grid, double * alt)
+* \param JD Julian day
+* \param grid Grid of geographic positions
+* \param alt Array of grid->n_lat * grid->n_lng elements to store altitudes
+*
+* Calculate altitude of the Sun of all points of a longitude/latitude
+* grid, see ln_get_body_alt_grid. The position of the Sun is calculated
+* once.
+*/
+void ln_get_solar_alt_grid (double JD, struct ln_lnlat_grid * grid, double * alt)
+{
+	struct ln_equ_posn equ;
+
+	ln_get_solar_equ_coords (JD, &equ);
+	get_grid (JD, &equ, grid, alt, 0);
+}
+
+/*! \fn void ln_get_solar_illum_grid (double JD, struct ln_lnlat_grid * grid, unsigned char * illum)
+* \param JD Julian day
+* \param grid Grid of geographic positions
+* \param illum Array of grid->n_lat * grid->n_lng elements to store illumination
+*
+* Calculate day/night mask of a longitude/latitude grid. Every point is
+* classified as LN_ILLUM_DAY when the Sun is above the standard horizon,
+* LN_ILLUM_CIVIL, LN_ILLUM_NAUTIC or LN_ILLUM_ASTRONOMICAL in the
+* respective twilight and LN_ILLUM_NIGHT otherwise. Points are stored as in
+* ln_get_body_alt_grid.
+*/
+void ln_get_solar_illum_grid (double JD, struct ln_lnlat_grid * grid, unsigned char * illum)
+{
+	struct ln_equ_posn equ;
+
+	ln_get_solar_equ_coords (JD, &equ);
+	get_grid (JD, &equ, grid, 0, illum);
+}
+
+/*! \fn void ln_get_body_terminator (double JD, struct ln_equ_posn * object, double horizon, double lng_start, double lng_step, int n_lng, double * lat, double * lat2, int * count)
+* \param JD Julian day
+* \param object Equatorial coordinates of object
+* \param horizon Altitude of the line in degrees, 0 or below
+* \param lng_start Longitude of the first point in degrees
+* \param lng_step Spacing of longitudes in degrees
+* \param n_lng Number of longitudes
+* \param lat Array of n_lng elements to store southern crossings
+* \param lat2 Array of n_lng elements to store northern crossings
+* \param count Array of n_lng elements to store number of crossings
+*
+* Calculate the line on the Earth where the object is at the given
+* altitude, the terminator for the Sun and horizon 0, or the limit of
+* twilight for negative horizons.
+*
+* A line below the horizon is a small circle, which may cross one
+* meridian twice, e.g. the astronomical twilight line crosses the midnight
+* meridian at both high northern and high southern latitudes around the
+* equinoxes. For every longitude the number of crossings, 0 to 2, is
+* stored in count, the southern crossing in lat and the northern crossing
+* in lat2. With a single crossing lat2 equals lat. When the object is
+* above the given altitude along the whole meridian, the line runs around
+* the pole on the far side from the object and both latitudes are set to
+* -90 or 90 degrees.
+*/
+void ln_get_body_terminator (double JD, struct ln_equ_posn * object, double horizon, double lng_start, double lng_step, int n_lng, double * lat, double * lat2, int * count)
+{
+	double sidereal, sin_dec, cos_dec, sin_h, a, r, phi, c, x;
+	int i, j, n;
+
+	sidereal = ln_get_mean_sidereal_time (JD) * 15.0;
+	sin_dec = sin (ln_deg_to_rad (object->dec));
+	cos_dec = cos (ln_deg_to_rad (object->dec));
+	sin_h = sin (ln_deg_to_rad (horizon));
+
+	for (i = 0; i < n_lng; i++) {
+		/* sin h = a cos lat + sin_dec sin lat = r cos (lat - phi) */
+		a = cos_dec * cos (ln_deg_to_rad (sidereal + lng_start +
+			i * lng_step - object->ra));
+		r = sqrt (a * a + sin_dec * sin_dec);
+		phi = ln_rad_to_deg (atan2 (sin_dec, a));
+
+		/* solutions phi +- c, keep those within -90 to 90 degrees */
+		n = 0;
+		if (sin_h > -r) {
+			c = ln_rad_to_deg (acos (sin_h / r));
+			for (j = -1; j <= 1; j += 2) {
+				x = phi + j * c;
+				if (x > 180.0)
+					x -= 360.0;
+				else if (x < -180.0)
+					x += 360.0;
+				if (x < -90.0 || x > 90.0)
+					continue;
+				if (n == 0)
+					lat[i] = lat2[i] = x;
+				else if (x < lat[i])
+					lat[i] = x;
+				else
+					lat2[i] = x;
+				n++;
+			}
+		}
+
+		if (n == 0)
+			lat[i] = lat2[i] = object->dec > 0 ? -90.0 : 90.0;
+		count[i] = n;
+	}
+}
@@ -356,7 +356,7 @@ int ln_get_date_from_mpc (struct ln_date* date, char* mpc_date)
 	/* day */
 	day[0] = *(mpc_date + 4);
 	day[1] = 0;
-	date->days = strtol (day, 0, 31);
+	date->days = strtol (day, 0, 32);
 	
 	/* reset hours,min,secs to 0 */
 	date->hours = 0;
@@ -22,6 +22,12 @@
 
 #include <libnova/ln_types.h> 
 
+/* airmass formulas */
+#define LN_AIRMASS_PLANE			0
+#define LN_AIRMASS_YOUNG			1
+#define LN_AIRMASS_KASTEN_YOUNG		2
+#define LN_AIRMASS_SCALE			3
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,6 +44,18 @@ double LIBNOVA_EXPORT ln_get_airmass (double alt, double airmass_scale);
  */
 double LIBNOVA_EXPORT ln_get_alt_from_airmass (double X, double airmass_scale);
 
+/*! \fn void ln_get_airmass_batch (int model, double airmass_scale, double k, double * alt, int count, double * airmass, double * extinction)
+ * \brief Calculate airmass and extinction for array of altitudes.
+ * \ingroup airmass
+ */
+void LIBNOVA_EXPORT ln_get_airmass_batch (int model, double airmass_scale, double k, double * alt, int count, double * airmass, double * extinction);
+
+/*! \fn void ln_get_airmass_grid (int model, double airmass_scale, double k, struct ln_equ_posn * objects, int n_objects, struct ln_lnlat_posn * observer, double JD_start, double JD_step, int n_JD, double * airmass, double * extinction)
+ * \brief Calculate airmass and extinction of many objects over a series of times.
+ * \ingroup airmass
+ */
+void LIBNOVA_EXPORT ln_get_airmass_grid (int model, double airmass_scale, double k, struct ln_equ_posn * objects, int n_objects, struct ln_lnlat_posn * observer, double JD_start, double JD_step, int n_JD, double * airmass, double * extinction);
+
 #ifdef __cplusplus
 };
 #endif
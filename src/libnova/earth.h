@@ -58,6 +58,18 @@ double LIBNOVA_EXPORT ln_get_earth_solar_dist (double JD);
 */
 void LIBNOVA_EXPORT ln_get_earth_rect_helio (double JD, struct ln_rect_posn * position);
 
+/*! \fn void ln_get_earth_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup earth
+* \brief Calculate Earth rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_earth_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
+/*! \fn void ln_get_earth_state (double JD, struct ln_earth_state * state)
+* \ingroup earth
+* \brief Calculate state of the Earth shared by calculations for one instant.
+*/
+void LIBNOVA_EXPORT ln_get_earth_state (double JD, struct ln_earth_state * state);
+
 /*! \fn void ln_get_earth_centre_dist (float height, double latitude, double * p_sin_o, double * p_cos_o);
 * \ingroup earth
 * \brief Calculate Earth globe centre distance.
@@ -0,0 +1,68 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _LN_ECLIPSE_H
+#define _LN_ECLIPSE_H
+
+#include <libnova/ln_types.h>
+
+#define LN_ECLIPSE_PENUMBRAL		0
+#define LN_ECLIPSE_PARTIAL			1
+#define LN_ECLIPSE_ANNULAR			2
+#define LN_ECLIPSE_TOTAL			3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+* \defgroup eclipse Eclipses and occultations
+*
+* Functions searching for solar and lunar eclipses and for lunar
+* occultations.
+*
+* All angles are expressed in degrees.
+*/
+
+/*! \fn int ln_get_solar_eclipses (double JD_start, double JD_end, struct ln_eclipse * eclipses, int max_eclipses);
+* \brief Find all solar eclipses in a time interval.
+* \ingroup eclipse
+*/
+int LIBNOVA_EXPORT ln_get_solar_eclipses (double JD_start, double JD_end, struct ln_eclipse * eclipses, int max_eclipses);
+
+/*! \fn int ln_get_lunar_eclipses (double JD_start, double JD_end, struct ln_eclipse * eclipses, int max_eclipses);
+* \brief Find all lunar eclipses in a time interval.
+* \ingroup eclipse
+*/
+int LIBNOVA_EXPORT ln_get_lunar_eclipses (double JD_start, double JD_end, struct ln_eclipse * eclipses, int max_eclipses);
+
+/*! \fn int ln_get_lunar_star_occultations (double JD_start, double JD_end, struct ln_equ_posn * stars, int n_stars, struct ln_occultation * occultations, int max_occultations);
+* \brief Find all lunar occultations of catalog stars in a time interval.
+* \ingroup eclipse
+*/
+int LIBNOVA_EXPORT ln_get_lunar_star_occultations (double JD_start, double JD_end, struct ln_equ_posn * stars, int n_stars, struct ln_occultation * occultations, int max_occultations);
+
+/*! \fn int ln_get_lunar_body_occultations (double JD_start, double JD_end, void (*get_equ_body_coords) (double, struct ln_equ_posn *), struct ln_occultation * occultations, int max_occultations);
+* \brief Find all lunar occultations of a planet or other moving body in a time interval.
+* \ingroup eclipse
+*/
+int LIBNOVA_EXPORT ln_get_lunar_body_occultations (double JD_start, double JD_end, void (*get_equ_body_coords) (double, struct ln_equ_posn *), struct ln_occultation * occultations, int max_occultations);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -38,6 +38,12 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_solve_kepler (double e, double M);
 
+/*! \fn void ln_solve_kepler_batch (double * e, double * M, double * E, int n);
+* \brief Calculate the eccentric anomaly for arrays of orbits.
+* \ingroup elliptic 
+*/
+void LIBNOVA_EXPORT ln_solve_kepler_batch (double * e, double * M, double * E, int n);
+
 /*! \fn double ln_get_ell_mean_anomaly (double n, double delta_JD);
 * \brief Calculate the mean anomaly.
 * \ingroup elliptic 
@@ -85,6 +91,12 @@ void LIBNOVA_EXPORT ln_get_ell_geo_rect_posn (struct ln_ell_orbit* orbit, double
 * \ingroup elliptic 
 */
 void LIBNOVA_EXPORT ln_get_ell_helio_rect_posn (struct ln_ell_orbit* orbit, double JD, struct ln_rect_posn* posn);
+
+/*! \fn void ln_get_ell_helio_rect_state (struct ln_ell_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel);
+* \ingroup elliptic
+* \brief Calculate the objects rectangular heliocentric position and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_ell_helio_rect_state (struct ln_ell_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel);
 	
 /*! \fn double ln_get_ell_orbit_len (struct ln_ell_orbit * orbit);
 * \brief Calculate the orbital length in AU.
@@ -0,0 +1,66 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _LN_EVENTS_H
+#define _LN_EVENTS_H
+
+#include <libnova/ln_types.h>
+
+#define LN_EVENT_RISE				0
+#define LN_EVENT_SET				1
+#define LN_EVENT_UPPER_TRANSIT		2
+#define LN_EVENT_LOWER_TRANSIT		3
+
+/* default sampling step, in days */
+#define LN_EVENT_DEFAULT_STEP		(1.0 / 24.0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+* \defgroup events Horizontal events
+*/
+
+/*! \fn int ln_get_body_hrz_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double step, double * thresholds, int n_thresholds, int transits, struct ln_hrz_event * events, int max_events);
+* \brief Find all altitude threshold crossings and meridian passages of a body in a time window.
+* \ingroup events
+*/
+int LIBNOVA_EXPORT ln_get_body_hrz_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double step, double * thresholds, int n_thresholds, int transits, struct ln_hrz_event * events, int max_events);
+
+/*! \fn int ln_get_body_airmass_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double step, double * airmasses, int n_airmasses, double airmass_scale, struct ln_hrz_event * events, int max_events);
+* \brief Find all airmass threshold crossings of a body in a time window.
+* \ingroup events
+*/
+int LIBNOVA_EXPORT ln_get_body_airmass_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double step, double * airmasses, int n_airmasses, double airmass_scale, struct ln_hrz_event * events, int max_events);
+
+/*! \fn int ln_get_object_hrz_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, struct ln_equ_posn * object, double * thresholds, int n_thresholds, int transits, struct ln_hrz_event * events, int max_events);
+* \brief Find all altitude threshold crossings and meridian passages of a fixed object in a time window.
+* \ingroup events
+*/
+int LIBNOVA_EXPORT ln_get_object_hrz_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, struct ln_equ_posn * object, double * thresholds, int n_thresholds, int transits, struct ln_hrz_event * events, int max_events);
+
+/*! \fn int ln_get_solar_twilight_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, struct ln_hrz_event * events, int max_events);
+* \brief Find sunrise, sunset and civil, nautical and astronomical twilight in a time window.
+* \ingroup events
+*/
+int LIBNOVA_EXPORT ln_get_solar_twilight_events (double JD_start, double JD_end, struct ln_lnlat_posn * observer, struct ln_hrz_event * events, int max_events);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
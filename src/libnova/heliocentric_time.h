@@ -21,6 +21,10 @@
 
 #include <libnova/ln_types.h>
 
+/* time corrections of ln_get_helio_time_diff_batch */
+#define LN_HELIO_TIME_HJD			0
+#define LN_HELIO_TIME_BJD_TDB		1
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,6 +40,18 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_get_heliocentric_time_diff (double JD, struct ln_equ_posn *object);
 
+/*! \fn double ln_get_tdb_tt_diff (double JD)
+* \ingroup heliocentric
+* \brief Calculate difference of TDB and TT in seconds
+*/
+double LIBNOVA_EXPORT ln_get_tdb_tt_diff (double JD);
+
+/*! \fn int ln_get_helio_time_diff_batch (struct ln_nbody_cache * cache, int mode, double * JD, double * ra, double * dec, int count, double * diff)
+* \ingroup heliocentric
+* \brief Calculate heliocentric or barycentric time corrections for arrays of times and objects
+*/
+int LIBNOVA_EXPORT ln_get_helio_time_diff_batch (struct ln_nbody_cache * cache, int mode, double * JD, double * ra, double * dec, int count, double * diff);
+
 #ifdef __cplusplus
 };
 #endif
@@ -62,6 +62,12 @@ void LIBNOVA_EXPORT ln_get_hyp_geo_rect_posn (struct ln_hyp_orbit* orbit, double
 * \brief Calculate an objects rectangular heliocentric position. 
 */
 void LIBNOVA_EXPORT ln_get_hyp_helio_rect_posn (struct ln_hyp_orbit* orbit, double JD, struct ln_rect_posn* posn);
+
+/*! \fn void ln_get_hyp_helio_rect_state (struct ln_hyp_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel);
+* \ingroup hyperbolic
+* \brief Calculate the objects rectangular heliocentric position and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_hyp_helio_rect_state (struct ln_hyp_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel);
 	
 /*!
 * \fn void ln_get_hyp_body_equ_coords (double JD, struct ln_hyp_orbit * orbit, struct ln_equ_posn * posn)
@@ -0,0 +1,88 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _LN_ILLUMINATION_H
+#define _LN_ILLUMINATION_H
+
+#include <libnova/ln_types.h>
+
+/* illumination classes of ln_get_solar_illum_grid */
+#define LN_ILLUM_NIGHT				0
+#define LN_ILLUM_ASTRONOMICAL		1
+#define LN_ILLUM_NAUTIC				2
+#define LN_ILLUM_CIVIL				3
+#define LN_ILLUM_DAY				4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \defgroup illumination Illumination
+*
+* Sub-solar and sub-lunar points, terminator and day/night mask of the
+* Earth, e.g. for map overlays and illumination of grids of ground
+* locations.
+*
+* All angles are expressed in degrees, longitudes are positive east.
+*/
+
+/*! \fn void ln_get_body_subpoint (double JD, struct ln_equ_posn * object, struct ln_lnlat_posn * subpoint)
+* \brief Calculate the geographic position where the object is in the zenith.
+* \ingroup illumination
+*/
+void LIBNOVA_EXPORT ln_get_body_subpoint (double JD, struct ln_equ_posn * object, struct ln_lnlat_posn * subpoint);
+
+/*! \fn void ln_get_solar_subpoint (double JD, struct ln_lnlat_posn * subpoint)
+* \brief Calculate the sub-solar point.
+* \ingroup illumination
+*/
+void LIBNOVA_EXPORT ln_get_solar_subpoint (double JD, struct ln_lnlat_posn * subpoint);
+
+/*! \fn void ln_get_lunar_subpoint (double JD, struct ln_lnlat_posn * subpoint)
+* \brief Calculate the sub-lunar point.
+* \ingroup illumination
+*/
+void LIBNOVA_EXPORT ln_get_lunar_subpoint (double JD, struct ln_lnlat_posn * subpoint);
+
+/*! \fn void ln_get_body_alt_grid (double JD, struct ln_equ_posn * object, struct ln_lnlat_grid * grid, double * alt)
+* \brief Calculate altitude of an object for all points of a longitude/latitude grid.
+* \ingroup illumination
+*/
+void LIBNOVA_EXPORT ln_get_body_alt_grid (double JD, struct ln_equ_posn * object, struct ln_lnlat_grid * grid, double * alt);
+
+/*! \fn void ln_get_solar_alt_grid (double JD, struct ln_lnlat_grid * grid, double * alt)
+* \brief Calculate altitude of the Sun for all points of a longitude/latitude grid.
+* \ingroup illumination
+*/
+void LIBNOVA_EXPORT ln_get_solar_alt_grid (double JD, struct ln_lnlat_grid * grid, double * alt);
+
+/*! \fn void ln_get_solar_illum_grid (double JD, struct ln_lnlat_grid * grid, unsigned char * illum)
+* \brief Calculate day/night mask of a longitude/latitude grid.
+* \ingroup illumination
+*/
+void LIBNOVA_EXPORT ln_get_solar_illum_grid (double JD, struct ln_lnlat_grid * grid, unsigned char * illum);
+
+/*! \fn void ln_get_body_terminator (double JD, struct ln_equ_posn * object, double horizon, double lng_start, double lng_step, int n_lng, double * lat, double * lat2, int * count)
+* \brief Calculate latitudes where the line of given object altitude crosses meridians.
+* \ingroup illumination
+*/
+void LIBNOVA_EXPORT ln_get_body_terminator (double JD, struct ln_equ_posn * object, double horizon, double lng_start, double lng_step, int n_lng, double * lat, double * lat2, int * count);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -39,12 +39,24 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_get_jupiter_equ_sdiam (double JD);
 
+/*! \fn double ln_get_jupiter_geom_equ_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the equatorial semidiameter of Jupiter in arc seconds from its geometry.
+* \ingroup jupiter
+*/
+double LIBNOVA_EXPORT ln_get_jupiter_geom_equ_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_jupiter_pol_sdiam (double JD)
 * \brief Calculate the polar semidiameter of Jupiter in arc seconds.
 * \ingroup jupiter
 */
 double LIBNOVA_EXPORT ln_get_jupiter_pol_sdiam (double JD);
 
+/*! \fn double ln_get_jupiter_geom_pol_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the polar semidiameter of Jupiter in arc seconds from its geometry.
+* \ingroup jupiter
+*/
+double LIBNOVA_EXPORT ln_get_jupiter_geom_pol_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_jupiter_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
 * \brief Calculate the time of rise, set and transit for Jupiter.
 * \ingroup jupiter
@@ -105,11 +117,29 @@ double LIBNOVA_EXPORT ln_get_jupiter_disk (double JD);
 /* Chapter 41 */
 double LIBNOVA_EXPORT ln_get_jupiter_phase (double JD);
 
+/*! \fn void ln_get_jupiter_geom (double JD, struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of Jupiter.
+* \ingroup jupiter
+*/
+void LIBNOVA_EXPORT ln_get_jupiter_geom (double JD, struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_jupiter_geom_magnitude (struct ln_planet_geom * geom);
+* \brief Calculate the visible magnitude of Jupiter from its geometry.
+* \ingroup jupiter
+*/
+double LIBNOVA_EXPORT ln_get_jupiter_geom_magnitude (struct ln_planet_geom * geom);
+
 /*! \fn void ln_get_jupiter_rect_helio (double JD, struct ln_rect_posn * position)
 * \ingroup jupiter
 * \brief Calculate Jupiters rectangular heliocentric coordinates.
 */
 void LIBNOVA_EXPORT ln_get_jupiter_rect_helio (double JD, struct ln_rect_posn * position);
+
+/*! \fn void ln_get_jupiter_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup jupiter
+* \brief Calculate Jupiter rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_jupiter_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
 	
 #ifdef __cplusplus
 };
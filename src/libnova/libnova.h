@@ -133,5 +133,15 @@
 #include <libnova/parallax.h>
 #include <libnova/airmass.h>
 #include <libnova/heliocentric_time.h>
+#include <libnova/events.h>
+#include <libnova/eclipse.h>
+#include <libnova/orbit.h>
+#include <libnova/nbody.h>
+#include <libnova/light_time.h>
+#include <libnova/mpc.h>
+#include <libnova/sky_index.h>
+#include <libnova/solar_system.h>
+#include <libnova/illumination.h>
+#include <libnova/observer.h>
 
 #endif
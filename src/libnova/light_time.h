@@ -0,0 +1,75 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef _LN_LIGHT_TIME_H
+#define _LN_LIGHT_TIME_H
+
+#include <libnova/ln_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \defgroup light_time Light time
+*
+* Correction of positions of planets and minor bodies for light time. The
+* position at the time light left the body is extrapolated from its
+* heliocentric position and velocity, so the series or orbit of the body
+* is evaluated only once.
+*/
+
+/*! \fn double ln_get_light_time_geo_posn (struct ln_rect_posn * earth, struct ln_rect_posn * posn, struct ln_rect_posn * vel, struct ln_rect_posn * geo);
+* \brief Calculate light time and light time corrected geocentric position from heliocentric state.
+* \ingroup light_time
+*/
+double LIBNOVA_EXPORT ln_get_light_time_geo_posn (struct ln_rect_posn * earth, struct ln_rect_posn * posn, struct ln_rect_posn * vel, struct ln_rect_posn * geo);
+
+/*! \fn double ln_get_body_light_time_geo_posn (double JD, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_rect_posn * geo);
+* \brief Calculate light time and light time corrected geocentric position of a body.
+* \ingroup light_time
+*/
+double LIBNOVA_EXPORT ln_get_body_light_time_geo_posn (double JD, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_rect_posn * geo);
+
+/*! \fn double ln_get_body_earth_state_equ_coords (struct ln_earth_state * earth, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_equ_posn * posn);
+* \brief Calculate light time corrected equatorial coordinates of a body from state of the Earth.
+* \ingroup light_time
+*/
+double LIBNOVA_EXPORT ln_get_body_earth_state_equ_coords (struct ln_earth_state * earth, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_equ_posn * posn);
+
+/*! \fn void ln_get_body_geom (double JD, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of a body.
+* \ingroup light_time
+*/
+void LIBNOVA_EXPORT ln_get_body_geom (double JD, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_planet_geom * geom);
+
+/*! \fn void ln_get_body_earth_state_geom (struct ln_earth_state * earth, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of a body from state of the Earth.
+* \ingroup light_time
+*/
+void LIBNOVA_EXPORT ln_get_body_earth_state_geom (struct ln_earth_state * earth, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_planet_geom_disk (struct ln_planet_geom * geom);
+* \brief Calculate the illuminated fraction of planet's disk from its geometry.
+* \ingroup light_time
+*/
+double LIBNOVA_EXPORT ln_get_planet_geom_disk (struct ln_planet_geom * geom);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -306,6 +306,126 @@ struct ln_hyp_orbit
 	double JD;	/*!< Time of last passage in Perihelion, in julian day*/
 };
 
+/*!
+* \struct ln_prep_orbit
+* \brief Prepared orbit
+*
+* Orbit of any type with the orientation of the orbital plane reduced to
+* two equatorial J2000 unit vectors, see ln_prep_ell_orbit.
+*
+* Distances are in AU.
+*/
+struct ln_prep_orbit
+{
+	int type;		/*!< Orbit type, see LN_ORBIT_XXX constants */
+	double q;		/*!< Perihelion distance */
+	double a;		/*!< Semi major axis, elliptic orbits only */
+	double b;		/*!< Semi minor axis, elliptic orbits only */
+	double e;		/*!< Eccentricity */
+	double n;		/*!< Mean motion in degrees/day, elliptic orbits only */
+	double JD;		/*!< Time of perihelion */
+	double P[3];	/*!< Unit vector towards perihelion */
+	double Q[3];	/*!< Unit vector in orbital plane 90 deg ahead of perihelion */
+};
+
+/*!
+* \struct ln_ell_orbits
+* \brief Elliptic orbital elements of many bodies
+*
+* Structure of arrays of elliptic orbital elements, each array has count
+* elements. Arrays are owned by the caller.
+*
+* Angles are expressed in degrees.
+*/
+struct ln_ell_orbits
+{
+	int count;		/*!< Number of orbits */
+	double *a;		/*!< Semi major axes, in AU */
+	double *e;		/*!< Eccentricities */
+	double *i;		/*!< Inclinations */
+	double *w;		/*!< Arguments of perihelion */
+	double *omega;	/*!< Longitudes of ascending node */
+	double *n;		/*!< Mean motions in degrees/day, 0 to calculate from a */
+	double *JD;		/*!< Times of perihelion */
+};
+
+/*!
+* \struct ln_prep_ell_orbits
+* \brief Prepared elliptic orbits of many bodies
+*
+* Structure of arrays with the same content as struct ln_prep_orbit, see
+* ln_prep_ell_orbits. Arrays point into a buffer owned by the caller.
+*/
+struct ln_prep_ell_orbits
+{
+	int count;		/*!< Number of orbits */
+	double *a;		/*!< Semi major axes, in AU */
+	double *b;		/*!< Semi minor axes, in AU */
+	double *e;		/*!< Eccentricities */
+	double *n;		/*!< Mean motions in degrees/day */
+	double *JD;		/*!< Times of perihelion */
+	double *P[3];	/*!< Components of unit vectors towards perihelion */
+	double *Q[3];	/*!< Components of unit vectors 90 deg ahead of perihelion */
+};
+
+/*!
+* \struct ln_mag_params
+* \brief Photometric parameters of asteroid or comet
+*
+* Parameters of the H, G magnitude system for asteroids or of the g, k
+* system for comets, see ln_get_asteroid_mag and ln_get_ell_comet_mag.
+*/
+struct ln_mag_params
+{
+	int type;		/*!< Magnitude system, see LN_MAG_XXX constants */
+	double H;		/*!< Absolute magnitude H, or g for comets */
+	double G;		/*!< Slope parameter G, or comet constant k */
+	double A;		/*!< Albedo for asteroids, 0 if unknown */
+};
+
+/*!
+* \struct ln_mpc_desig
+* \brief Catalogue index entry
+*
+* Packed MPC designation of a body and its index in catalogue, see
+* ln_get_mpcorb_orbits and ln_find_mpc_desig.
+*/
+struct ln_mpc_desig
+{
+	char desig[16];	/*!< Packed designation without spaces */
+	int index;		/*!< Index of body in catalogue */
+};
+
+/*!
+* \struct ln_sky_entry
+* \brief Entry of sky index
+*
+* Position of a body and its index in the array passed to
+* ln_prep_sky_index.
+*/
+struct ln_sky_entry
+{
+	double ra;		/*!< Right ascension, in degrees */
+	double dec;		/*!< Declination, in degrees */
+	int index;		/*!< Index of body in position array */
+};
+
+/*!
+* \struct ln_sky_index
+* \brief Sky index for cone searches
+*
+* Positions sorted into declination zones of equal height, and by right
+* ascension within each zone. Arrays point into buffers owned by the
+* caller, see ln_prep_sky_index.
+*/
+struct ln_sky_index
+{
+	double zone_height;			/*!< Height of declination zone, in degrees */
+	int zones;					/*!< Number of zones */
+	int *zone_start;			/*!< Index of first entry of each zone, zones + 1 elements */
+	struct ln_sky_entry *entries;	/*!< Entries sorted by zone and right ascension */
+};
+
 /*!
 * \struct ln_rst_time
 * \brief Rise, Set and Transit times. 
@@ -336,6 +456,275 @@ struct ln_nutation
 	double ecliptic;	/*!< Mean obliquity of the ecliptic, in degrees */
 };
 
+/*!
+* \struct ln_lunar_event
+* \brief Lunar phase or apsis.
+*
+* Time of a principal lunar phase or of the lunar perigee or apogee.
+*/
+struct ln_lunar_event
+{
+	double JD;			/*!< Time of the event in JD */
+	int type;			/*!< Phase or apsis, see LN_LUNAR_XXX constants */
+	double dist;		/*!< Earth - Moon distance at the event in km */
+};
+
+/*!
+* \struct ln_hrz_event
+* \brief Horizontal event.
+*
+* Time and type of an altitude threshold crossing or a meridian passage
+* of a body, as found by the event search functions.
+*/
+struct ln_hrz_event
+{
+	double JD;			/*!< Time of the event in JD */
+	int type;			/*!< Event type, see LN_EVENT_XXX constants */
+	int threshold;		/*!< Index of crossed threshold, -1 for meridian passages */
+};
+
+/*!
+* \struct ln_eclipse
+* \brief Solar or lunar eclipse.
+*
+* Time of greatest eclipse, its type and magnitude.
+*
+* Angles are expressed in degrees.
+*/
+struct ln_eclipse
+{
+	double JD;			/*!< Time of greatest eclipse in JD */
+	int type;			/*!< Eclipse type, see LN_ECLIPSE_XXX constants */
+	double magnitude;	/*!< Magnitude of the eclipse */
+	double separation;	/*!< Geocentric separation of the Moon from the Sun or the shadow axis */
+};
+
+/*!
+* \struct ln_occultation
+* \brief Lunar occultation.
+*
+* Time of geocentric closest approach of the Moon to an occulted object.
+*
+* Angles are expressed in degrees.
+*/
+struct ln_occultation
+{
+	double JD;			/*!< Time of geocentric closest approach in JD */
+	int index;			/*!< Index of the occulted star */
+	double separation;	/*!< Geocentric separation at closest approach */
+};
+
+/* perturbing planets Mercury to Neptune in N-body integration */
+#define LN_NBODY_PLANETS	8
+
+/*!
+* \struct ln_nbody_cache
+* \brief Positions of perturbing planets.
+*
+* Heliocentric rectangular equatorial J2000 positions and velocities of
+* perturbing planets at equally spaced nodes, shared by all integrated
+* bodies. Arrays are provided by the caller and hold
+* nodes * LN_NBODY_PLANETS elements, planets of one node being consecutive.
+*
+* Distances are in AU, velocities in AU per day.
+*/
+struct ln_nbody_cache
+{
+	double JD;						/*!< Time of the first node in JD */
+	double step;					/*!< Spacing of nodes in days */
+	int nodes;						/*!< Number of nodes */
+	double GM[LN_NBODY_PLANETS];	/*!< Gravitational parameters of planets in AU^3/day^2 */
+	struct ln_rect_posn *posn;		/*!< Positions of planets */
+	struct ln_rect_posn *vel;		/*!< Velocities of planets */
+};
+
+/*!
+* \struct ln_nbody_state
+* \brief State of integrated body.
+*
+* Heliocentric rectangular equatorial J2000 state of a minor body. The
+* structure holds everything needed to continue integration, so it can
+* be copied or written to a file as a checkpoint.
+*
+* Distances are in AU, velocities in AU per day.
+*/
+struct ln_nbody_state
+{
+	double JD;					/*!< Time of the state in JD */
+	double step;				/*!< Last integrator step in days, 0 if not known */
+	struct ln_rect_posn posn;	/*!< Position */
+	struct ln_rect_posn vel;	/*!< Velocity */
+};
+
+/*!
+* \struct ln_earth_state
+* \brief State of the Earth at one instant.
+*
+* Everything about the Earth needed by geocentric and topocentric
+* calculations for one epoch, see ln_get_earth_state. Calculated once, it
+* can be passed to functions computing many bodies for the same instant.
+*
+* Angles are expressed in degrees, distances in AU, velocities in AU per day.
+*/
+struct ln_earth_state
+{
+	double JD;						/*!< Time of the state in JD */
+	struct ln_helio_posn helio;		/*!< Heliocentric ecliptical position, FK5 */
+	struct ln_rect_posn posn;		/*!< Heliocentric rectangular equatorial position */
+	struct ln_rect_posn vel;		/*!< Heliocentric rectangular equatorial velocity */
+	struct ln_nutation nutation;	/*!< Nutation and mean obliquity of the ecliptic */
+	double obliquity;				/*!< True obliquity of the ecliptic */
+	double sidereal;				/*!< Apparent sidereal time at Greenwich, in hours */
+};
+
+/*!
+* \struct ln_planet_geom
+* \brief Geometry of the Sun, the Earth and a planet.
+*
+* Distances and phase angle from which the apparent physical quantities of
+* a planet are derived, see ln_get_body_geom. The planet's position is
+* corrected for light time.
+*
+* Distances are in AU, angles in degrees.
+*/
+struct ln_planet_geom
+{
+	struct ln_rect_posn geo;	/*!< Geocentric rectangular equatorial position */
+	double r;					/*!< Distance of the planet from the Sun */
+	double delta;				/*!< Distance of the planet from the Earth */
+	double R;					/*!< Distance of the Earth from the Sun */
+	double phase;				/*!< Phase angle Sun - planet - Earth */
+};
+
+/* Sun, Moon, Mercury to Neptune except the Earth, and Pluto */
+#define LN_SOLAR_SYSTEM_BODIES	10
+
+/*!
+* \struct ln_body_snapshot
+* \brief Position and appearance of a body.
+*
+* Angles are expressed in degrees, distances in AU.
+*/
+struct ln_body_snapshot
+{
+	struct ln_equ_posn equ;	/*!< Equatorial coordinates, as of ln_get_XXX_equ_coords */
+	double earth_dist;		/*!< Distance from the Earth */
+	double solar_dist;		/*!< Distance from the Sun */
+	double magnitude;		/*!< Visual magnitude */
+	double phase;			/*!< Phase angle Sun - body - Earth */
+	double disk;			/*!< Illuminated fraction of the disk */
+	double sdiam;			/*!< Semidiameter in arc seconds, equatorial for Jupiter and Saturn */
+};
+
+/*!
+* \struct ln_solar_system
+* \brief Snapshot of the solar system.
+*
+* All bodies of the solar system at one instant, see
+* ln_get_solar_system. Bodies are indexed by LN_BODY_XXX constants.
+*/
+struct ln_solar_system
+{
+	struct ln_earth_state earth;							/*!< State of the Earth */
+	struct ln_body_snapshot body[LN_SOLAR_SYSTEM_BODIES];	/*!< Bodies */
+};
+
+/*!
+* \struct ln_topo_observer
+* \brief Observer prepared for topocentric reductions.
+*
+* Geographic position of observer with its geocentric constants and
+* local apparent sidereal time, see ln_prep_topo_observer.
+*/
+struct ln_topo_observer
+{
+	double lng;			/*!< Longitude in degrees, positive east */
+	double lat;			/*!< Latitude in degrees */
+	double ro_sin;		/*!< rho sin phi' in Earth radii */
+	double ro_cos;		/*!< rho cos phi' in Earth radii */
+	double JD;			/*!< Time of observation in JD */
+	double sidereal;	/*!< Local apparent sidereal time in hours */
+};
+
+/*!
+* \struct ln_observer_state
+* \brief Geocentric state of observer.
+*
+* Position and velocity of observer in the equatorial frame of date,
+* advanced by fixed time steps, see ln_prep_observer_state.
+*
+* Distances are in AU, velocities in AU per day.
+*/
+struct ln_observer_state
+{
+	double JD;					/*!< Time of the state in JD */
+	double JD_start;			/*!< Time of the first state in JD */
+	long steps;					/*!< Number of steps from the first state */
+	double step;				/*!< Time step in days */
+	double cos_step;			/*!< Cosine of rotation in one step */
+	double sin_step;			/*!< Sine of rotation in one step */
+	struct ln_rect_posn posn;	/*!< Geocentric position */
+	struct ln_rect_posn vel;	/*!< Geocentric velocity */
+};
+
+/*!
+* \struct ln_refraction
+* \brief Refraction model.
+*
+* Refraction model and its coefficients for given atmospheric conditions,
+* see ln_prep_refraction.
+*/
+struct ln_refraction
+{
+	int model;			/*!< LN_REFRACTION_XXX model */
+	double factor;		/*!< Pressure and temperature factor of Bennett model, arc minutes to degrees */
+	double A;			/*!< Coefficient of tan z in radians */
+	double B;			/*!< Coefficient of tan^3 z in radians */
+};
+
+/*!
+* \struct ln_lnlat_grid
+* \brief Grid of geographic positions.
+*
+* Regular grid of n_lat rows of equal latitude and n_lng columns of equal
+* longitude. Longitudes are positive east.
+*
+* Angles are expressed in degrees.
+*/
+struct ln_lnlat_grid
+{
+	double lng_start;	/*!< Longitude of the first column */
+	double lng_step;	/*!< Spacing of columns */
+	int n_lng;			/*!< Number of columns */
+	double lat_start;	/*!< Latitude of the first row */
+	double lat_step;	/*!< Spacing of rows */
+	int n_lat;			/*!< Number of rows */
+};
+
+/* maximum number of Chebyshev terms of solar engine */
+#define LN_SOLAR_CHEB_TERMS		16
+
+/*!
+* \struct ln_solar_engine
+* \brief Solar position engine.
+*
+* Method and precomputed data used to calculate apparent solar
+* position, see ln_prep_solar_engine. In LN_SOLAR_ENGINE_CHEB mode, ra
+* and dec hold Chebyshev coefficients of right ascension and declination
+* over the time span JD_start to JD_end.
+*
+* Angles are expressed in degrees.
+*/
+struct ln_solar_engine
+{
+	int mode;							/*!< LN_SOLAR_ENGINE_XXX method */
+	double JD_start;					/*!< Start of fitted span in JD */
+	double JD_end;						/*!< End of fitted span in JD */
+	int terms;							/*!< Number of Chebyshev terms */
+	double ra[LN_SOLAR_CHEB_TERMS];		/*!< Coefficients of right ascension */
+	double dec[LN_SOLAR_CHEB_TERMS];	/*!< Coefficients of declination */
+};
+
 /* Definitions of POSIX structures for Win32. */
 #ifdef __WIN32__
 
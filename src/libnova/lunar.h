@@ -23,6 +23,16 @@
 
 #define LN_LUNAR_STANDART_HORIZON		0.125
 
+/* principal phases */
+#define LN_LUNAR_NEW					0
+#define LN_LUNAR_FIRST_QUARTER			1
+#define LN_LUNAR_FULL					2
+#define LN_LUNAR_LAST_QUARTER			3
+
+/* apsides */
+#define LN_LUNAR_PERIGEE				0
+#define LN_LUNAR_APOGEE					1
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -108,6 +118,30 @@ double LIBNOVA_EXPORT ln_get_lunar_long_asc_node (double JD);
 */ 
 double LIBNOVA_EXPORT ln_get_lunar_long_perigee (double JD);
 
+/*! \fn double ln_get_lunar_next_phase (double JD, int phase);
+* \brief Calculate time of the next principal lunar phase.
+* \ingroup lunar
+*/
+double LIBNOVA_EXPORT ln_get_lunar_next_phase (double JD, int phase);
+
+/*! \fn int ln_get_lunar_phases (double JD_start, double JD_end, struct ln_lunar_event * events, int max_events);
+* \brief Calculate times of all principal lunar phases in a time interval.
+* \ingroup lunar
+*/
+int LIBNOVA_EXPORT ln_get_lunar_phases (double JD_start, double JD_end, struct ln_lunar_event * events, int max_events);
+
+/*! \fn double ln_get_lunar_next_apsis (double JD, int apsis, double * dist);
+* \brief Calculate time of the next lunar perigee or apogee.
+* \ingroup lunar
+*/
+double LIBNOVA_EXPORT ln_get_lunar_next_apsis (double JD, int apsis, double * dist);
+
+/*! \fn int ln_get_lunar_apsides (double JD_start, double JD_end, struct ln_lunar_event * events, int max_events);
+* \brief Calculate times of all lunar perigees and apogees in a time interval.
+* \ingroup lunar
+*/
+int LIBNOVA_EXPORT ln_get_lunar_apsides (double JD_start, double JD_end, struct ln_lunar_event * events, int max_events);
+
 #ifdef __cplusplus
 };
 #endif
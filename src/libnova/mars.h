@@ -37,6 +37,12 @@ extern "C" {
 * \ingroup mars
 */
 double LIBNOVA_EXPORT ln_get_mars_sdiam (double JD);
+
+/*! \fn double ln_get_mars_geom_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the semidiameter of Mars in arc seconds from its geometry.
+* \ingroup mars
+*/
+double LIBNOVA_EXPORT ln_get_mars_geom_sdiam (struct ln_planet_geom * geom);
 	
 /*! \fn double ln_get_mars_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
 * \brief Calculate the time of rise, set and transit for Mars.
@@ -98,11 +104,29 @@ double LIBNOVA_EXPORT ln_get_mars_disk (double JD);
 /* Chapter 41 */
 double LIBNOVA_EXPORT ln_get_mars_phase (double JD);
 
+/*! \fn void ln_get_mars_geom (double JD, struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of Mars.
+* \ingroup mars
+*/
+void LIBNOVA_EXPORT ln_get_mars_geom (double JD, struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_mars_geom_magnitude (struct ln_planet_geom * geom);
+* \brief Calculate the visible magnitude of Mars from its geometry.
+* \ingroup mars
+*/
+double LIBNOVA_EXPORT ln_get_mars_geom_magnitude (struct ln_planet_geom * geom);
+
 /*! \fn void ln_get_mars_rect_helio (double JD, struct ln_rect_posn * position)
 * \ingroup mars
 * \brief Calculate Mars rectangular heliocentric coordinates.
 */
 void LIBNOVA_EXPORT ln_get_mars_rect_helio (double JD, struct ln_rect_posn * position);
+
+/*! \fn void ln_get_mars_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup mars
+* \brief Calculate Mars rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_mars_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
 	
 #ifdef __cplusplus
 };
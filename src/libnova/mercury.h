@@ -38,6 +38,12 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_get_mercury_sdiam (double JD);
 
+/*! \fn double ln_get_mercury_geom_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the semidiameter of Mercury in arc seconds from its geometry.
+* \ingroup mercury
+*/
+double LIBNOVA_EXPORT ln_get_mercury_geom_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_mercury_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
 * \brief Calculate the time of rise, set and transit for Mercury.
 * \ingroup mercury
@@ -99,6 +105,18 @@ double LIBNOVA_EXPORT ln_get_mercury_disk (double JD);
 /* Chapter 41 */
 double LIBNOVA_EXPORT ln_get_mercury_phase (double JD);
 
+/*! \fn void ln_get_mercury_geom (double JD, struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of Mercury.
+* \ingroup mercury
+*/
+void LIBNOVA_EXPORT ln_get_mercury_geom (double JD, struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_mercury_geom_magnitude (struct ln_planet_geom * geom);
+* \brief Calculate the visible magnitude of Mercury from its geometry.
+* \ingroup mercury
+*/
+double LIBNOVA_EXPORT ln_get_mercury_geom_magnitude (struct ln_planet_geom * geom);
+
 
 /*! \fn void ln_get_mercury_rect_helio (double JD, struct ln_rect_posn * position)
 * \ingroup mercury
@@ -106,6 +124,12 @@ double LIBNOVA_EXPORT ln_get_mercury_phase (double JD);
 */
 void LIBNOVA_EXPORT ln_get_mercury_rect_helio (double JD, struct ln_rect_posn * position);
 
+/*! \fn void ln_get_mercury_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup mercury
+* \brief Calculate Mercury rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_mercury_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
 #ifdef __cplusplus
 };
 #endif
@@ -0,0 +1,76 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _LN_MPC_H
+#define _LN_MPC_H
+
+#include <libnova/ln_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \defgroup mpc MPC orbital elements
+*
+* Readers of orbital elements in the fixed width formats of the Minor
+* Planet Center, MPCORB.DAT for minor planets and CometEls.txt for comets.
+* Files are read from a buffer supplied by the caller, e.g. a file mapped
+* into memory, and no memory is allocated.
+*
+* All angles are expressed in degrees.
+*/
+
+/*! \fn int ln_get_ell_orbit_from_mpcorb (const char * line, int len, struct ln_ell_orbit * orbit, struct ln_mag_params * params);
+* \brief Read orbit of minor planet from line of MPCORB file.
+* \ingroup mpc
+*/
+int LIBNOVA_EXPORT ln_get_ell_orbit_from_mpcorb (const char * line, int len, struct ln_ell_orbit * orbit, struct ln_mag_params * params);
+
+/*! \fn int ln_get_hyp_orbit_from_cometels (const char * line, int len, struct ln_hyp_orbit * orbit, struct ln_mag_params * params);
+* \brief Read orbit of comet from line of CometEls file.
+* \ingroup mpc
+*/
+int LIBNOVA_EXPORT ln_get_hyp_orbit_from_cometels (const char * line, int len, struct ln_hyp_orbit * orbit, struct ln_mag_params * params);
+
+/*! \fn int ln_get_mpcorb_orbits (const char * buffer, long size, struct ln_prep_orbit * prep, struct ln_mag_params * params, struct ln_mpc_desig * desig, int max);
+* \brief Read prepared orbits of all minor planets in MPCORB file.
+* \ingroup mpc
+*/
+int LIBNOVA_EXPORT ln_get_mpcorb_orbits (const char * buffer, long size, struct ln_prep_orbit * prep, struct ln_mag_params * params, struct ln_mpc_desig * desig, int max);
+
+/*! \fn int ln_get_cometels_orbits (const char * buffer, long size, struct ln_prep_orbit * prep, struct ln_mag_params * params, struct ln_mpc_desig * desig, int max);
+* \brief Read prepared orbits of all comets in CometEls file.
+* \ingroup mpc
+*/
+int LIBNOVA_EXPORT ln_get_cometels_orbits (const char * buffer, long size, struct ln_prep_orbit * prep, struct ln_mag_params * params, struct ln_mpc_desig * desig, int max);
+
+/*! \fn void ln_sort_mpc_desig (struct ln_mpc_desig * desig, int count);
+* \brief Sort catalogue index by packed designation.
+* \ingroup mpc
+*/
+void LIBNOVA_EXPORT ln_sort_mpc_desig (struct ln_mpc_desig * desig, int count);
+
+/*! \fn int ln_find_mpc_desig (struct ln_mpc_desig * desig, int count, const char * packed);
+* \brief Find body in sorted catalogue index by packed designation.
+* \ingroup mpc
+*/
+int LIBNOVA_EXPORT ln_find_mpc_desig (struct ln_mpc_desig * desig, int count, const char * packed);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _LN_NBODY_H
+#define _LN_NBODY_H
+
+#include <libnova/ln_types.h>
+
+/* default spacing of planet cache nodes, in days */
+#define LN_NBODY_DEFAULT_STEP		1.0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \defgroup nbody Perturbed motion
+*
+* Numerical integration of minor bodies perturbed by the planets. Planet
+* positions are taken from VSOP87 at nodes of a cache shared by all
+* integrated bodies. Integration uses adaptive Dormand-Prince 5(4)
+* Runge-Kutta method.
+*
+* Coordinates are heliocentric rectangular equatorial J2000 in AU, time is
+* in julian days.
+*/
+
+/*! \fn int ln_get_nbody_cache_nodes (double JD_start, double JD_end, double step);
+* \brief Calculate number of cache nodes needed to cover a time interval.
+* \ingroup nbody
+*/
+int LIBNOVA_EXPORT ln_get_nbody_cache_nodes (double JD_start, double JD_end, double step);
+
+/*! \fn void ln_prep_nbody_cache (double JD, double step, int nodes, struct ln_rect_posn * posn, struct ln_rect_posn * vel, struct ln_nbody_cache * cache);
+* \brief Calculate planet positions at cache nodes.
+* \ingroup nbody
+*/
+void LIBNOVA_EXPORT ln_prep_nbody_cache (double JD, double step, int nodes, struct ln_rect_posn * posn, struct ln_rect_posn * vel, struct ln_nbody_cache * cache);
+
+/*! \fn void ln_get_nbody_cache_planets (struct ln_nbody_cache * cache, double JD, struct ln_rect_posn * posn);
+* \brief Interpolate positions of perturbing planets from cache.
+* \ingroup nbody
+*/
+void LIBNOVA_EXPORT ln_get_nbody_cache_planets (struct ln_nbody_cache * cache, double JD, struct ln_rect_posn * posn);
+
+/*! \fn void ln_prep_nbody_state (struct ln_prep_orbit * prep, double JD, struct ln_nbody_state * state);
+* \brief Set integration state from osculating orbit.
+* \ingroup nbody
+*/
+void LIBNOVA_EXPORT ln_prep_nbody_state (struct ln_prep_orbit * prep, double JD, struct ln_nbody_state * state);
+
+/*! \fn int ln_nbody_integrate (struct ln_nbody_cache * cache, struct ln_nbody_state * state, double JD);
+* \brief Integrate motion of a body to given time.
+* \ingroup nbody
+*/
+int LIBNOVA_EXPORT ln_nbody_integrate (struct ln_nbody_cache * cache, struct ln_nbody_state * state, double JD);
+
+/*! \fn int ln_nbody_integrate_bodies (struct ln_nbody_cache * cache, struct ln_nbody_state * states, int count, double JD);
+* \brief Integrate motion of many bodies to given time.
+* \ingroup nbody
+*/
+int LIBNOVA_EXPORT ln_nbody_integrate_bodies (struct ln_nbody_cache * cache, struct ln_nbody_state * states, int count, double JD);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -38,6 +38,12 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_get_neptune_sdiam (double JD);
 
+/*! \fn double ln_get_neptune_geom_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the semidiameter of Neptune in arc seconds from its geometry.
+* \ingroup neptune
+*/
+double LIBNOVA_EXPORT ln_get_neptune_geom_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_neptune_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
 * \brief Calculate the time of rise, set and transit for Neptune.
 * \ingroup neptune
@@ -98,12 +104,30 @@ double LIBNOVA_EXPORT ln_get_neptune_disk (double JD);
 /* Chapter 41 */
 double LIBNOVA_EXPORT ln_get_neptune_phase (double JD);
 
+/*! \fn void ln_get_neptune_geom (double JD, struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of Neptune.
+* \ingroup neptune
+*/
+void LIBNOVA_EXPORT ln_get_neptune_geom (double JD, struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_neptune_geom_magnitude (struct ln_planet_geom * geom);
+* \brief Calculate the visible magnitude of Neptune from its geometry.
+* \ingroup neptune
+*/
+double LIBNOVA_EXPORT ln_get_neptune_geom_magnitude (struct ln_planet_geom * geom);
+
 /*! \fn void ln_get_neptune_rect_helio (double JD, struct ln_rect_posn * position)
 * \ingroup neptune
 * \brief Calculate Neptunes rectangular heliocentric coordinates.
 */
 void LIBNOVA_EXPORT ln_get_neptune_rect_helio (double JD, struct ln_rect_posn * position);
 
+/*! \fn void ln_get_neptune_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup neptune
+* \brief Calculate Neptune rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_neptune_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
 #ifdef __cplusplus
 };
 #endif
@@ -0,0 +1,64 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef _LN_OBSERVER_H
+#define _LN_OBSERVER_H
+
+#include <libnova/ln_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \defgroup observer Observer state
+*
+* Geocentric position and velocity of an observer on the rotating Earth,
+* e.g. for diurnal aberration and topocentric Doppler corrections.
+* Observers are prepared by ln_prep_topo_observer.
+*
+* Distances are in AU, velocities in AU per day.
+*/
+
+/*! \fn void ln_get_observer_itrs_posn (struct ln_topo_observer * topo, struct ln_rect_posn * posn)
+* \brief Calculate position of observer in terrestrial frame.
+* \ingroup observer
+*/
+void LIBNOVA_EXPORT ln_get_observer_itrs_posn (struct ln_topo_observer * topo, struct ln_rect_posn * posn);
+
+/*! \fn void ln_get_observer_rect_state (struct ln_topo_observer * topo, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \brief Calculate geocentric equatorial position and velocity of observer.
+* \ingroup observer
+*/
+void LIBNOVA_EXPORT ln_get_observer_rect_state (struct ln_topo_observer * topo, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
+/*! \fn void ln_prep_observer_state (struct ln_topo_observer * topo, double JD, double step, struct ln_observer_state * state)
+* \brief Prepare observer state for equally spaced times.
+* \ingroup observer
+*/
+void LIBNOVA_EXPORT ln_prep_observer_state (struct ln_topo_observer * topo, double JD, double step, struct ln_observer_state * state);
+
+/*! \fn void ln_next_observer_state (struct ln_observer_state * state)
+* \brief Advance observer state by one time step.
+* \ingroup observer
+*/
+void LIBNOVA_EXPORT ln_next_observer_state (struct ln_observer_state * state);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _LN_ORBIT_H
+#define _LN_ORBIT_H
+
+#include <libnova/ln_types.h>
+
+#define LN_ORBIT_ELLIPTIC		0
+#define LN_ORBIT_PARABOLIC		1
+#define LN_ORBIT_HYPERBOLIC		2
+
+#define LN_MAG_ASTEROID			0
+#define LN_MAG_COMET			1
+
+/* number of doubles per orbit in ln_prep_ell_orbits buffer */
+#define LN_PREP_ELL_ORBIT_DOUBLES	11
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \defgroup orbit Prepared orbits
+*
+* Functions for repeated propagation of elliptic, parabolic and hyperbolic
+* orbits. Constants depending only on orbital elements are computed once.
+*
+* All angles are expressed in degrees.
+*/
+
+/*! \fn void ln_prep_ell_orbit (struct ln_ell_orbit * orbit, struct ln_prep_orbit * prep);
+* \brief Prepare elliptic orbit for propagation.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_prep_ell_orbit (struct ln_ell_orbit * orbit, struct ln_prep_orbit * prep);
+
+/*! \fn void ln_prep_par_orbit (struct ln_par_orbit * orbit, struct ln_prep_orbit * prep);
+* \brief Prepare parabolic orbit for propagation.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_prep_par_orbit (struct ln_par_orbit * orbit, struct ln_prep_orbit * prep);
+
+/*! \fn void ln_prep_hyp_orbit (struct ln_hyp_orbit * orbit, struct ln_prep_orbit * prep);
+* \brief Prepare hyperbolic orbit for propagation.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_prep_hyp_orbit (struct ln_hyp_orbit * orbit, struct ln_prep_orbit * prep);
+
+/*! \fn void ln_get_prep_helio_rect_posn (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn);
+* \brief Calculate heliocentric rectangular position of body on prepared orbit.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_get_prep_helio_rect_posn (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn);
+
+/*! \fn double ln_solve_universal (double q, double e, double t);
+* \brief Solve Kepler's equation in universal variable.
+* \ingroup orbit
+*/
+double LIBNOVA_EXPORT ln_solve_universal (double q, double e, double t);
+
+/*! \fn void ln_prep_univ_orbit (struct ln_hyp_orbit * orbit, struct ln_prep_orbit * prep);
+* \brief Prepare orbit of any eccentricity for propagation.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_prep_univ_orbit (struct ln_hyp_orbit * orbit, struct ln_prep_orbit * prep);
+
+/*! \fn void ln_get_prep_univ_helio_rect_posn (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn);
+* \brief Calculate heliocentric rectangular position on prepared orbit with universal variable.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_get_prep_univ_helio_rect_posn (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn);
+
+/*! \fn void ln_get_prep_helio_rect_state (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+* \brief Calculate heliocentric rectangular position and velocity of body on prepared orbit.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_get_prep_helio_rect_state (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
+/*! \fn void ln_get_prep_univ_helio_rect_state (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+* \brief Calculate heliocentric rectangular position and velocity on prepared orbit with universal variable.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_get_prep_univ_helio_rect_state (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
+/*! \fn void ln_get_prep_univ_equ_coords (double JD, struct ln_prep_orbit * prep, int count, struct ln_equ_posn * posn, double * dist);
+* \brief Calculate equatorial coordinates of bodies on array of prepared orbits of any type.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_get_prep_univ_equ_coords (double JD, struct ln_prep_orbit * prep, int count, struct ln_equ_posn * posn, double * dist);
+
+/*! \fn void ln_prep_ell_orbits (struct ln_ell_orbits * orbits, double * buffer, struct ln_prep_ell_orbits * prep);
+* \brief Prepare arrays of elliptic orbits for bulk propagation.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_prep_ell_orbits (struct ln_ell_orbits * orbits, double * buffer, struct ln_prep_ell_orbits * prep);
+
+/*! \fn void ln_get_prep_ell_orbits_equ_coords_chunk (double JD, struct ln_prep_ell_orbits * prep, struct ln_rect_posn * earth, int start, int count, double * ra, double * dec, double * dist);
+* \brief Calculate equatorial coordinates of a chunk of prepared elliptic orbits.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_get_prep_ell_orbits_equ_coords_chunk (double JD, struct ln_prep_ell_orbits * prep, struct ln_rect_posn * earth, int start, int count, double * ra, double * dec, double * dist);
+
+/*! \fn void ln_get_prep_ell_orbits_equ_coords (double JD, struct ln_prep_ell_orbits * prep, double * ra, double * dec, double * dist);
+* \brief Calculate equatorial coordinates of all prepared elliptic orbits.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_get_prep_ell_orbits_equ_coords (double JD, struct ln_prep_ell_orbits * prep, double * ra, double * dec, double * dist);
+
+/*! \fn void ln_get_prep_orbits_mag (double JD, struct ln_prep_orbit * prep, struct ln_mag_params * params, int count, double * mag, double * phase, double * elong, double * diam);
+* \brief Calculate magnitudes, phase angles, elongations and apparent diameters of bodies on array of prepared orbits.
+* \ingroup orbit
+*/
+void LIBNOVA_EXPORT ln_get_prep_orbits_mag (double JD, struct ln_prep_orbit * prep, struct ln_mag_params * params, int count, double * mag, double * phase, double * elong, double * diam);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
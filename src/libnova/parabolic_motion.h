@@ -62,6 +62,12 @@ void LIBNOVA_EXPORT ln_get_par_geo_rect_posn (struct ln_par_orbit* orbit, double
 * \brief Calculate an objects rectangular heliocentric position. 
 */
 void LIBNOVA_EXPORT ln_get_par_helio_rect_posn (struct ln_par_orbit* orbit, double JD, struct ln_rect_posn* posn);
+
+/*! \fn void ln_get_par_helio_rect_state (struct ln_par_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel);
+* \ingroup parabolic
+* \brief Calculate the objects rectangular heliocentric position and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_par_helio_rect_state (struct ln_par_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel);
 	
 /*!
 * \fn void ln_get_par_body_equ_coords (double JD, struct ln_par_orbit * orbit, struct ln_equ_posn * posn)
@@ -37,6 +37,30 @@ void LIBNOVA_EXPORT ln_get_parallax (struct ln_equ_posn * object, double au_dist
 */
 void LIBNOVA_EXPORT ln_get_parallax_ha (struct ln_equ_posn * object, double au_distance, struct ln_lnlat_posn * observer, double height, double H, struct ln_equ_posn * parallax);
 
+/*! \fn void ln_prep_topo_observer (struct ln_lnlat_posn * observer, double height, struct ln_topo_observer * topo)
+* \ingroup parallax
+* \brief Prepare observer for topocentric reductions.
+*/
+void LIBNOVA_EXPORT ln_prep_topo_observer (struct ln_lnlat_posn * observer, double height, struct ln_topo_observer * topo);
+
+/*! \fn void ln_set_topo_observers_time (struct ln_topo_observer * topo, int count, double JD)
+* \ingroup parallax
+* \brief Set time of observation of prepared observers.
+*/
+void LIBNOVA_EXPORT ln_set_topo_observers_time (struct ln_topo_observer * topo, int count, double JD);
+
+/*! \fn void ln_get_topo_parallax (struct ln_topo_observer * topo, struct ln_equ_posn * object, double au_distance, struct ln_equ_posn * parallax)
+* \ingroup parallax
+* \brief Calculate parallax in RA and DEC for prepared observer
+*/
+void LIBNOVA_EXPORT ln_get_topo_parallax (struct ln_topo_observer * topo, struct ln_equ_posn * object, double au_distance, struct ln_equ_posn * parallax);
+
+/*! \fn void ln_get_topo_equ_coords_batch (struct ln_topo_observer * topo, double * ra, double * dec, double * dist, int count, double * topo_ra, double * topo_dec, double * topo_dist)
+* \ingroup parallax
+* \brief Calculate topocentric coordinates of many objects for prepared observer
+*/
+void LIBNOVA_EXPORT ln_get_topo_equ_coords_batch (struct ln_topo_observer * topo, double * ra, double * dec, double * dist, int count, double * topo_ra, double * topo_dec, double * topo_dist);
+
 #ifdef __cplusplus
 };
 #endif
@@ -38,6 +38,12 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_get_pluto_sdiam (double JD);
 
+/*! \fn double ln_get_pluto_geom_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the semidiameter of Pluto in arc seconds from its geometry.
+* \ingroup pluto
+*/
+double LIBNOVA_EXPORT ln_get_pluto_geom_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_pluto_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
 * \brief Calculate the time of rise, set and transit for Pluto.
 * \ingroup pluto
@@ -98,12 +104,30 @@ double LIBNOVA_EXPORT ln_get_pluto_disk (double JD);
 /* Chapter 41 */
 double LIBNOVA_EXPORT ln_get_pluto_phase (double JD);
 
+/*! \fn void ln_get_pluto_geom (double JD, struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of Pluto.
+* \ingroup pluto
+*/
+void LIBNOVA_EXPORT ln_get_pluto_geom (double JD, struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_pluto_geom_magnitude (struct ln_planet_geom * geom);
+* \brief Calculate the visible magnitude of Pluto from its geometry.
+* \ingroup pluto
+*/
+double LIBNOVA_EXPORT ln_get_pluto_geom_magnitude (struct ln_planet_geom * geom);
+
 /*! \fn void ln_get_pluto_rect_helio (double JD, struct ln_rect_posn * position)
 * \ingroup pluto
 * \brief Calculate Plutos rectangular heliocentric coordinates.
 */
 void LIBNOVA_EXPORT ln_get_pluto_rect_helio (double JD, struct ln_rect_posn * position);
 
+/*! \fn void ln_get_pluto_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup pluto
+* \brief Calculate Plutos rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_pluto_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
 #ifdef __cplusplus
 };
 #endif
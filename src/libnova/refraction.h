@@ -21,6 +21,13 @@
 
 #include <libnova/ln_types.h>
 
+/* refraction models */
+#define LN_REFRACTION_BENNETT		0
+#define LN_REFRACTION_RIGOROUS		1
+
+/* lowest altitude used by the rigorous model, in degrees */
+#define LN_REFRACTION_MIN_ALT		3.0
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,6 +45,48 @@ extern "C" {
 * \ingroup refraction
 */
 double LIBNOVA_EXPORT ln_get_refraction_adj (double altitude, double atm_pres, double temp);
+
+/*! \fn double ln_get_refraction_bennett (double apparent, double atm_pres, double temp)
+* \brief Calculate refraction for apparent altitude by Bennett's formula.
+* \ingroup refraction
+*/
+double LIBNOVA_EXPORT ln_get_refraction_bennett (double apparent, double atm_pres, double temp);
+
+/*! \fn double ln_get_refraction_saemundsson (double altitude, double atm_pres, double temp)
+* \brief Calculate refraction for true altitude by Saemundsson's formula.
+* \ingroup refraction
+*/
+double LIBNOVA_EXPORT ln_get_refraction_saemundsson (double altitude, double atm_pres, double temp);
+
+/*! \fn int ln_prep_refraction (int model, double atm_pres, double temp, double humidity, double wavelength, struct ln_refraction * refr)
+* \brief Prepare refraction model for given atmospheric conditions.
+* \ingroup refraction
+*/
+int LIBNOVA_EXPORT ln_prep_refraction (int model, double atm_pres, double temp, double humidity, double wavelength, struct ln_refraction * refr);
+
+/*! \fn double ln_get_apparent_alt (struct ln_refraction * refr, double altitude)
+* \brief Calculate apparent altitude from true altitude.
+* \ingroup refraction
+*/
+double LIBNOVA_EXPORT ln_get_apparent_alt (struct ln_refraction * refr, double altitude);
+
+/*! \fn double ln_get_true_alt (struct ln_refraction * refr, double apparent)
+* \brief Calculate true altitude from apparent altitude.
+* \ingroup refraction
+*/
+double LIBNOVA_EXPORT ln_get_true_alt (struct ln_refraction * refr, double apparent);
+
+/*! \fn void ln_get_apparent_alt_batch (struct ln_refraction * refr, double * altitude, double * apparent, int count)
+* \brief Calculate apparent altitudes from array of true altitudes.
+* \ingroup refraction
+*/
+void LIBNOVA_EXPORT ln_get_apparent_alt_batch (struct ln_refraction * refr, double * altitude, double * apparent, int count);
+
+/*! \fn void ln_get_true_alt_batch (struct ln_refraction * refr, double * apparent, double * altitude, int count)
+* \brief Calculate true altitudes from array of apparent altitudes.
+* \ingroup refraction
+*/
+void LIBNOVA_EXPORT ln_get_true_alt_batch (struct ln_refraction * refr, double * apparent, double * altitude, int count);
 	
 #ifdef __cplusplus
 };
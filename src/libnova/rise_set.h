@@ -71,6 +71,18 @@ int LIBNOVA_EXPORT ln_get_object_next_rst_horizon (double JD, struct ln_lnlat_po
  */
 int LIBNOVA_EXPORT ln_get_body_rst_horizon (double JD, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double horizon, struct ln_rst_time * rst);
 
+/*! \fn int ln_get_body_rst_horizon_table (double JD, int days, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double horizon, struct ln_rst_time * rst, int * ret);
+ * \brief Calculate rise, set and transit times of a body for a range of days, evaluating the body only once per day.
+ * \ingroup rst
+ */
+int LIBNOVA_EXPORT ln_get_body_rst_horizon_table (double JD, int days, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double horizon, struct ln_rst_time * rst, int * ret);
+
+/*! \fn int ln_get_body_rst_horizon_observers (double JD, int count, struct ln_lnlat_posn * observers, double * horizons, void (*get_equ_body_coords) (double, struct ln_equ_posn *), struct ln_rst_time * rst, int * ret);
+ * \brief Calculate rise, set and transit times of a body for many observers, evaluating the body only once.
+ * \ingroup rst
+ */
+int LIBNOVA_EXPORT ln_get_body_rst_horizon_observers (double JD, int count, struct ln_lnlat_posn * observers, double * horizons, void (*get_equ_body_coords) (double, struct ln_equ_posn *), struct ln_rst_time * rst, int * ret);
+
 /*! \fn int ln_get_body_next_rst_horizon (double JD, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double horizon, struct ln_rst_time *rst);
  * \brief Calculate the time of next  rise, set and transit for an object a body, usually Sun, a planet or Moon.
  * E.g. it's sure, that rise, set and transit will be in <JD, JD+1> range.
@@ -38,12 +38,24 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_get_saturn_equ_sdiam (double JD);
 
+/*! \fn double ln_get_saturn_geom_equ_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the equatorial semidiameter of Saturn in arc seconds from its geometry.
+* \ingroup saturn
+*/
+double LIBNOVA_EXPORT ln_get_saturn_geom_equ_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_saturn_pol_sdiam (double JD)
 * \brief Calculate the polar semidiameter of Saturn in arc seconds.
 * \ingroup saturn
 */
 double LIBNOVA_EXPORT ln_get_saturn_pol_sdiam (double JD);
 
+/*! \fn double ln_get_saturn_geom_pol_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the polar semidiameter of Saturn in arc seconds from its geometry.
+* \ingroup saturn
+*/
+double LIBNOVA_EXPORT ln_get_saturn_geom_pol_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_saturn_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
 * \brief Calculate the time of rise, set and transit for Saturn.
 * \ingroup saturn
@@ -104,12 +116,30 @@ double LIBNOVA_EXPORT ln_get_saturn_disk (double JD);
 /* Chapter 41 */
 double LIBNOVA_EXPORT ln_get_saturn_phase (double JD);
 
+/*! \fn void ln_get_saturn_geom (double JD, struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of Saturn.
+* \ingroup saturn
+*/
+void LIBNOVA_EXPORT ln_get_saturn_geom (double JD, struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_saturn_geom_magnitude (struct ln_planet_geom * geom);
+* \brief Calculate the visible magnitude of Saturn from its geometry.
+* \ingroup saturn
+*/
+double LIBNOVA_EXPORT ln_get_saturn_geom_magnitude (struct ln_planet_geom * geom);
+
 /*! \fn void ln_get_saturn_rect_helio (double JD, struct ln_rect_posn * position)
 * \ingroup saturns
 * \brief Calculate Saturns rectangular heliocentric coordinates.
 */
 void LIBNOVA_EXPORT ln_get_saturn_rect_helio (double JD, struct ln_rect_posn * position);
 
+/*! \fn void ln_get_saturn_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup saturn
+* \brief Calculate Saturn rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_saturn_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
 #ifdef __cplusplus
 };
 #endif
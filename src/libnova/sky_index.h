@@ -0,0 +1,60 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _LN_SKY_INDEX_H
+#define _LN_SKY_INDEX_H
+
+#include <libnova/ln_types.h>
+
+/* default height of declination zone, in degrees */
+#define LN_SKY_INDEX_DEFAULT_ZONE	1.0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \defgroup sky_index Sky index
+*
+* Index of many positions on the sky, e.g. of a catalogue of minor bodies
+* computed by ln_get_prep_univ_equ_coords, answering cone searches without
+* scanning all positions.
+*
+* All angles are expressed in degrees.
+*/
+
+/*! \fn int ln_get_sky_index_zones (double zone_height);
+* \brief Calculate number of declination zones of sky index.
+* \ingroup sky_index
+*/
+int LIBNOVA_EXPORT ln_get_sky_index_zones (double zone_height);
+
+/*! \fn void ln_prep_sky_index (struct ln_equ_posn * posn, int count, double zone_height, int * zone_start, struct ln_sky_entry * entries, struct ln_sky_index * index);
+* \brief Build sky index of array of positions.
+* \ingroup sky_index
+*/
+void LIBNOVA_EXPORT ln_prep_sky_index (struct ln_equ_posn * posn, int count, double zone_height, int * zone_start, struct ln_sky_entry * entries, struct ln_sky_index * index);
+
+/*! \fn int ln_get_sky_index_cone (struct ln_sky_index * index, struct ln_equ_posn * centre, double radius, int * found, int max_found);
+* \brief Find all positions in sky index within radius of centre.
+* \ingroup sky_index
+*/
+int LIBNOVA_EXPORT ln_get_sky_index_cone (struct ln_sky_index * index, struct ln_equ_posn * centre, double radius, int * found, int max_found);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -26,6 +26,11 @@
 #define LN_SOLAR_NAUTIC_HORIZON                -12.0 
 #define LN_SOLAR_ASTRONOMICAL_HORIZON          -18.0
 
+/* solar engine methods */
+#define LN_SOLAR_ENGINE_VSOP87		0
+#define LN_SOLAR_ENGINE_LOW			1
+#define LN_SOLAR_ENGINE_CHEB		2
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -73,6 +78,12 @@ void LIBNOVA_EXPORT ln_get_solar_ecl_coords (double JD, struct ln_lnlat_posn * p
 * \ingroup solar
 */
 void LIBNOVA_EXPORT ln_get_solar_geo_coords (double JD, struct ln_rect_posn * position);
+
+/*! \fn void ln_get_solar_earth_state_equ_coords (struct ln_earth_state * earth, struct ln_equ_posn * position)
+* \brief Calculate apparent equatorial solar coordinates from state of the Earth.
+* \ingroup solar
+*/
+void LIBNOVA_EXPORT ln_get_solar_earth_state_equ_coords (struct ln_earth_state * earth, struct ln_equ_posn * position);
 	
 /*! \fn double ln_get_solar_sdiam (double JD)
 * \brief Calculate the semidiameter of the Sun in arc seconds.
@@ -80,6 +91,30 @@ void LIBNOVA_EXPORT ln_get_solar_geo_coords (double JD, struct ln_rect_posn * po
 */
 double LIBNOVA_EXPORT ln_get_solar_sdiam (double JD);
 
+/*! \fn void ln_get_solar_equ_coords_low (double JD, struct ln_equ_posn * position)
+* \brief Calculate apparent equatorial solar coordinates with low accuracy.
+* \ingroup solar
+*/
+void LIBNOVA_EXPORT ln_get_solar_equ_coords_low (double JD, struct ln_equ_posn * position);
+
+/*! \fn int ln_prep_solar_engine (int mode, double JD_start, double JD_end, int terms, struct ln_solar_engine * engine)
+* \brief Prepare solar position engine of given method.
+* \ingroup solar
+*/
+int LIBNOVA_EXPORT ln_prep_solar_engine (int mode, double JD_start, double JD_end, int terms, struct ln_solar_engine * engine);
+
+/*! \fn void ln_get_solar_engine_equ_coords (struct ln_solar_engine * engine, double JD, struct ln_equ_posn * position)
+* \brief Calculate apparent equatorial solar coordinates with solar engine.
+* \ingroup solar
+*/
+void LIBNOVA_EXPORT ln_get_solar_engine_equ_coords (struct ln_solar_engine * engine, double JD, struct ln_equ_posn * position);
+
+/*! \fn void ln_get_solar_engine_hrz_coords (struct ln_solar_engine * engine, double JD, struct ln_lnlat_posn * observers, int count, struct ln_hrz_posn * position)
+* \brief Calculate horizontal solar coordinates for many observers.
+* \ingroup solar
+*/
+void LIBNOVA_EXPORT ln_get_solar_engine_hrz_coords (struct ln_solar_engine * engine, double JD, struct ln_lnlat_posn * observers, int count, struct ln_hrz_posn * position);
+
 #ifdef __cplusplus
 };
 #endif
@@ -0,0 +1,55 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _LN_SOLAR_SYSTEM_H
+#define _LN_SOLAR_SYSTEM_H
+
+#include <libnova/ln_types.h>
+
+#define LN_BODY_SUN			0
+#define LN_BODY_MOON		1
+#define LN_BODY_MERCURY		2
+#define LN_BODY_VENUS		3
+#define LN_BODY_MARS		4
+#define LN_BODY_JUPITER		5
+#define LN_BODY_SATURN		6
+#define LN_BODY_URANUS		7
+#define LN_BODY_NEPTUNE		8
+#define LN_BODY_PLUTO		9
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \defgroup solar_system Solar system
+*
+* Positions and appearance of the Sun, the Moon and the planets at one
+* instant, computed together.
+*
+* All angles are expressed in degrees.
+*/
+
+/*! \fn void ln_get_solar_system (double JD, struct ln_solar_system * system);
+* \brief Calculate positions, distances, magnitudes, phases and semidiameters of all bodies of the solar system.
+* \ingroup solar_system
+*/
+void LIBNOVA_EXPORT ln_get_solar_system (double JD, struct ln_solar_system * system);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -73,6 +73,20 @@ void LIBNOVA_EXPORT ln_get_equ_from_hrz (struct ln_hrz_posn *object, struct ln_l
 /* Pg ?? */
 void LIBNOVA_EXPORT ln_get_rect_from_helio (struct ln_helio_posn *object, struct ln_rect_posn * position); 
 
+/*! \fn void ln_get_rect_state_from_helio (struct ln_helio_posn *object, struct ln_helio_posn *rate, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+* \brief Calculate rectangular position and velocity from heliocentric coordinates and their rate.
+* \ingroup transform
+*/
+void LIBNOVA_EXPORT ln_get_rect_state_from_helio (struct ln_helio_posn *object, struct ln_helio_posn *rate, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
+/*! \fn void ln_get_equ_from_rect (struct ln_rect_posn * rect, struct ln_equ_posn * posn)
+* \ingroup transform
+* \brief Transform an objects rectangular equatorial coordinates into equatorial coordinates.
+*/
+/* Equ 33.10
+*/
+void LIBNOVA_EXPORT ln_get_equ_from_rect (struct ln_rect_posn * rect, struct ln_equ_posn * posn);
+
 /*! \fn void ln_get_ecl_from_rect (struct ln_rect_posn * rect, struct ln_lnlat_posn * posn)
 * \ingroup transform
 * \brief Transform an objects rectangular coordinates into ecliptical coordinates.
@@ -39,6 +39,12 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_get_uranus_sdiam (double JD);
 
+/*! \fn double ln_get_uranus_geom_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the semidiameter of Uranus in arc seconds from its geometry.
+* \ingroup uranus
+*/
+double LIBNOVA_EXPORT ln_get_uranus_geom_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_uranus_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
 * \brief Calculate the time of rise, set and transit for Uranus.
 * \ingroup uranus
@@ -99,12 +105,30 @@ double LIBNOVA_EXPORT ln_get_uranus_disk (double JD);
 /* Chapter 41 */
 double LIBNOVA_EXPORT ln_get_uranus_phase (double JD);
 
+/*! \fn void ln_get_uranus_geom (double JD, struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of Uranus.
+* \ingroup uranus
+*/
+void LIBNOVA_EXPORT ln_get_uranus_geom (double JD, struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_uranus_geom_magnitude (struct ln_planet_geom * geom);
+* \brief Calculate the visible magnitude of Uranus from its geometry.
+* \ingroup uranus
+*/
+double LIBNOVA_EXPORT ln_get_uranus_geom_magnitude (struct ln_planet_geom * geom);
+
 /*! \fn void ln_get_uranus_rect_helio (double JD, struct ln_rect_posn * position)
 * \ingroup uranus
 * \brief Calculate Uranus rectangular heliocentric coordinates.
 */
 void LIBNOVA_EXPORT ln_get_uranus_rect_helio (double JD, struct ln_rect_posn * position);
 
+/*! \fn void ln_get_uranus_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup uranus
+* \brief Calculate Uranus rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_uranus_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
 #ifdef __cplusplus
 };
 #endif
@@ -38,6 +38,12 @@ extern "C" {
 */
 double LIBNOVA_EXPORT ln_get_venus_sdiam (double JD);
 
+/*! \fn double ln_get_venus_geom_sdiam (struct ln_planet_geom * geom)
+* \brief Calculate the semidiameter of Venus in arc seconds from its geometry.
+* \ingroup venus
+*/
+double LIBNOVA_EXPORT ln_get_venus_geom_sdiam (struct ln_planet_geom * geom);
+
 /*! \fn double ln_get_venus_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
 * \brief Calculate the time of rise, set and transit for Venus.
 * \ingroup venus
@@ -98,11 +104,29 @@ double LIBNOVA_EXPORT ln_get_venus_disk (double JD);
 /* Chapter 41 */
 double LIBNOVA_EXPORT ln_get_venus_phase (double JD);
 
+/*! \fn void ln_get_venus_geom (double JD, struct ln_planet_geom * geom);
+* \brief Calculate distances and phase angle of Venus.
+* \ingroup venus
+*/
+void LIBNOVA_EXPORT ln_get_venus_geom (double JD, struct ln_planet_geom * geom);
+
+/*! \fn double ln_get_venus_geom_magnitude (struct ln_planet_geom * geom);
+* \brief Calculate the visible magnitude of Venus from its geometry.
+* \ingroup venus
+*/
+double LIBNOVA_EXPORT ln_get_venus_geom_magnitude (struct ln_planet_geom * geom);
+
 /*! \fn void ln_get_venus_rect_helio (double JD, struct ln_rect_posn * position)
 * \ingroup venus
 * \brief Calculate Venus rectangular heliocentric coordinates.
 */
 void LIBNOVA_EXPORT ln_get_venus_rect_helio (double JD, struct ln_rect_posn * position);
+
+/*! \fn void ln_get_venus_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \ingroup venus
+* \brief Calculate Venus rectangular heliocentric coordinates and velocity.
+*/
+void LIBNOVA_EXPORT ln_get_venus_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
 	
 #ifdef __cplusplus
 };
@@ -50,6 +50,16 @@ struct ln_vsop
 
 double LIBNOVA_EXPORT ln_calc_series (const struct ln_vsop * data, int terms, double t);
 
+double LIBNOVA_EXPORT ln_calc_series_dot (const struct ln_vsop * data, int terms, double t, double * dot);
+
+double LIBNOVA_EXPORT ln_calc_series_poly (const double * series, const double * series_dot, int n, double t, double * dot);
+
+/*! \fn void ln_vsop87_rect_state (struct ln_helio_posn * position, struct ln_helio_posn * rate, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+* \ingroup VSOP87
+* \brief Transform VSOP87 heliocentric position and its rate to FK5 rectangular position and velocity.
+*/
+void LIBNOVA_EXPORT ln_vsop87_rect_state (struct ln_helio_posn * position, struct ln_helio_posn * rate, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+
 #ifdef __cplusplus
 };
 #endif
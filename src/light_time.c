@@ -0,0 +1,187 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <libnova/light_time.h>
+#include <libnova/earth.h>
+#include <libnova/transform.h>
+#include <libnova/utility.h>
+
+#define GAUS_GRAV	0.01720209895	// Gaussian gravitational constant k
+
+/* maximal number of light time iterations */
+#define LIGHT_TIME_ITER		10
+
+/*! \fn double ln_get_light_time_geo_posn (struct ln_rect_posn * earth, struct ln_rect_posn * posn, struct ln_rect_posn * vel, struct ln_rect_posn * geo);
+* \param earth Heliocentric rectangular position of the Earth at JD
+* \param posn Heliocentric rectangular position of body at JD
+* \param vel Heliocentric velocity of body at JD in AU per day
+* \param geo Pointer to store geocentric position of body at JD - light time
+* \return Light time in days
+*
+* Solve light time equation for body with known heliocentric state. Position
+* of body at JD - t is extrapolated by second order Taylor polynomial, with
+* acceleration due to the Sun, so the equation is iterated without further
+* evaluation of the body's position. The error of extrapolation is below
+* 1e-8 AU for all planets.
+*/
+double ln_get_light_time_geo_posn (struct ln_rect_posn * earth,
+	struct ln_rect_posn * posn, struct ln_rect_posn * vel,
+	struct ln_rect_posn * geo)
+{
+	double r, f, t = 0, last;
+	int i;
+
+	/* half of solar acceleration divided by position */
+	r = sqrt (posn->X * posn->X + posn->Y * posn->Y + posn->Z * posn->Z);
+	f = -GAUS_GRAV * GAUS_GRAV / (2 * r * r * r);
+
+	for (i = 0; i < LIGHT_TIME_ITER; i++) {
+		last = t;
+		geo->X = posn->X * (1 + f * t * t) - vel->X * t - earth->X;
+		geo->Y = posn->Y * (1 + f * t * t) - vel->Y * t - earth->Y;
+		geo->Z = posn->Z * (1 + f * t * t) - vel->Z * t - earth->Z;
+		t = ln_get_light_time (sqrt (geo->X * geo->X + geo->Y * geo->Y +
+			geo->Z * geo->Z));
+		if (fabs (t - last) < 1e-12)
+			break;
+	}
+
+	return t;
+}
+
+/*! \fn double ln_get_body_light_time_geo_posn (double JD, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_rect_posn * geo);
+* \param JD Julian day
+* \param get_helio_state Function returning heliocentric position and velocity of body, e.g. ln_get_mars_rect_helio_state
+* \param geo Pointer to store geocentric position of body at JD - light time
+* \return Light time in days
+*
+* Calculate geocentric rectangular equatorial position of body corrected
+* for light time, with single evaluation of body's state.
+*/
+double ln_get_body_light_time_geo_posn (double JD,
+	void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *),
+	struct ln_rect_posn * geo)
+{
+	struct ln_rect_posn earth, posn, vel;
+
+	ln_get_earth_rect_helio (JD, &earth);
+	get_helio_state (JD, &posn, &vel);
+
+	return ln_get_light_time_geo_posn (&earth, &posn, &vel, geo);
+}
+
+/*! \fn double ln_get_body_earth_state_equ_coords (struct ln_earth_state * earth, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_equ_posn * posn);
+* \param earth State of the Earth from ln_get_earth_state
+* \param get_helio_state Function returning heliocentric position and velocity of body, e.g. ln_get_mars_rect_helio_state
+* \param posn Pointer to store equatorial coordinates
+* \return Distance of body from the Earth in AU
+*
+* Calculate geocentric equatorial coordinates of body, corrected for light
+* time, using precomputed state of the Earth. Results are the same as of
+* ln_get_mars_equ_coords and the other planet functions.
+*/
+double ln_get_body_earth_state_equ_coords (struct ln_earth_state * earth,
+	void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *),
+	struct ln_equ_posn * posn)
+{
+	struct ln_rect_posn body, vel, geo;
+
+	get_helio_state (earth->JD, &body, &vel);
+	ln_get_light_time_geo_posn (&earth->posn, &body, &vel, &geo);
+	ln_get_equ_from_rect (&geo, posn);
+
+	return sqrt (geo.X * geo.X + geo.Y * geo.Y + geo.Z * geo.Z);
+}
+
+/* geometry of body with known heliocentric state */
+static void get_geom (struct ln_rect_posn * earth, struct ln_rect_posn * posn,
+	struct ln_rect_posn * vel, struct ln_planet_geom * geom)
+{
+	struct ln_rect_posn *geo = &geom->geo;
+	double X, Y, Z, r, delta, R;
+
+	ln_get_light_time_geo_posn (earth, posn, vel, geo);
+
+	/* heliocentric position at JD - light time */
+	X = geo->X + earth->X;
+	Y = geo->Y + earth->Y;
+	Z = geo->Z + earth->Z;
+
+	r = sqrt (X * X + Y * Y + Z * Z);
+	delta = sqrt (geo->X * geo->X + geo->Y * geo->Y + geo->Z * geo->Z);
+	R = sqrt (earth->X * earth->X + earth->Y * earth->Y + earth->Z * earth->Z);
+
+	geom->r = r;
+	geom->delta = delta;
+	geom->R = R;
+	geom->phase = ln_rad_to_deg (acos ((r * r + delta * delta - R * R) /
+		(2 * r * delta)));
+}
+
+/*! \fn void ln_get_body_geom (double JD, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_planet_geom * geom);
+* \param JD Julian day
+* \param get_helio_state Function returning heliocentric position and velocity of body, e.g. ln_get_mars_rect_helio_state
+* \param geom Pointer to store geometry
+*
+* Calculate light time corrected geocentric position, distances from the
+* Sun and the Earth and phase angle of body, with single evaluation of
+* body's state. Magnitude, illuminated fraction and semidiameter of
+* planets are derived from the geometry, e.g. by
+* ln_get_mars_geom_magnitude and ln_get_planet_geom_disk.
+*/
+void ln_get_body_geom (double JD,
+	void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *),
+	struct ln_planet_geom * geom)
+{
+	struct ln_rect_posn earth, posn, vel;
+
+	ln_get_earth_rect_helio (JD, &earth);
+	get_helio_state (JD, &posn, &vel);
+	get_geom (&earth, &posn, &vel, geom);
+}
+
+/*! \fn void ln_get_body_earth_state_geom (struct ln_earth_state * earth, void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *), struct ln_planet_geom * geom);
+* \param earth State of the Earth from ln_get_earth_state
+* \param get_helio_state Function returning heliocentric position and velocity of body
+* \param geom Pointer to store geometry
+*
+* Calculate geometry of body as ln_get_body_geom, using precomputed state
+* of the Earth.
+*/
+void ln_get_body_earth_state_geom (struct ln_earth_state * earth,
+	void (*get_helio_state) (double, struct ln_rect_posn *, struct ln_rect_posn *),
+	struct ln_planet_geom * geom)
+{
+	struct ln_rect_posn posn, vel;
+
+	get_helio_state (earth->JD, &posn, &vel);
+	get_geom (&earth->posn, &posn, &vel, geom);
+}
+
+/*! \fn double ln_get_planet_geom_disk (struct ln_planet_geom * geom);
+* \param geom Geometry of planet
+* \return Illuminated fraction of planet's disk
+*
+* Calculate the illuminated fraction of planet's disk from its geometry.
+*/
+/* Chapter 41 */
+double ln_get_planet_geom_disk (struct ln_planet_geom * geom)
+{
+	double r = geom->r, delta = geom->delta, R = geom->R;
+
+	return (((r + delta) * (r + delta)) - R * R) / (4 * r * delta);
+}
@@ -39293,6 +39293,7 @@ void ln_get_lunar_geo_posn (double JD, struct ln_rect_posn * moon, double precis
 
 	/* save cache and result */
 	c_JD = JD;
+	c_precision = precision;
 	c_X = moon->X = a;
 	c_Y = moon->Y = b;
 	c_Z = moon->Z = c;
@@ -39528,6 +39529,272 @@ double ln_get_lunar_long_perigee (double JD)
 	return per;
 }
 
+/* precision of phase and apsis times in days (~0.1s) */
+#define LUNAR_EVENT_PRECISION	1e-6
+#define LUNAR_EVENT_MAX_ITER	30
+
+/* mean synodic and anomalistic month, Meeus chap 49 and 50 */
+#define SYNODIC_MONTH			29.530588861
+#define ANOMALISTIC_MONTH		27.55454989
+
+/* time of mean phase for lunation k, equ 49.1 */
+static double get_mean_phase (double k)
+{
+	double T = k / 1236.85;
+	double T2 = T * T;
+
+	return 2451550.09766 + SYNODIC_MONTH * k + 0.00015437 * T2
+		- 0.000000150 * T2 * T + 0.00000000073 * T2 * T2;
+}
+
+/* time of mean apsis for k, equ 50.1 */
+static double get_mean_apsis (double k)
+{
+	double T = k / 1325.55;
+	double T2 = T * T;
+
+	return 2451534.6698 + ANOMALISTIC_MONTH * k - 0.0006691 * T2
+		- 0.000001098 * T2 * T + 0.0000000052 * T2 * T2;
+}
+
+/* lunar elongation from the Sun in longitude, in degrees <-180, 180> */
+static double get_lunar_elong (double JD)
+{
+	struct ln_lnlat_posn moon;
+	struct ln_helio_posn sol;
+
+	/* both are referred to the J2000 ecliptic, so the difference is the
+	   same as for the equinox of date; nutation cancels out too */
+	ln_get_lunar_ecl_coords (JD, &moon, 0.00001);
+	ln_get_solar_geom_coords (JD, &sol);
+	sol.L -= (20.4898 / 3600.0) / sol.R;
+
+	return ln_range_degrees (moon.lng - sol.L + 180.0) - 180.0;
+}
+
+/* find phase of lunation k by secant method started from mean phase */
+static double get_lunar_phase_time (double k, int phase)
+{
+	double JD0, JD1, f0, f1, JD;
+	int i;
+
+	JD0 = get_mean_phase (k);
+	JD1 = JD0 + 0.1;
+	f0 = ln_range_degrees (get_lunar_elong (JD0) - 90.0 * phase + 180.0) - 180.0;
+
+	for (i = 0; i < LUNAR_EVENT_MAX_ITER; i++) {
+		f1 = ln_range_degrees (get_lunar_elong (JD1) - 90.0 * phase + 180.0) - 180.0;
+		if (f1 == f0)
+			break;
+		JD = JD1 - f1 * (JD1 - JD0) / (f1 - f0);
+		JD0 = JD1;
+		f0 = f1;
+		JD1 = JD;
+		if (fabs (JD1 - JD0) < LUNAR_EVENT_PRECISION)
+			break;
+	}
+	return JD1;
+}
+
+/* Earth - Moon distance from the complete ELP series; the truncation of
+   ln_get_lunar_earth_dist shifts the flat extremes by minutes */
+static double get_lunar_dist (double JD)
+{
+	struct ln_rect_posn moon;
+
+	ln_get_lunar_geo_posn (JD, &moon, 0);
+	return sqrt ((moon.X * moon.X) + (moon.Y * moon.Y) + (moon.Z * moon.Z));
+}
+
+/* find apsis near mean apsis k by successive parabolic interpolation */
+static double get_lunar_apsis_time (double k, int apsis, double *dist)
+{
+	double s[13], x[3], f[3], JD, fx, d, sign, JD0;
+	int i, j = 0;
+
+	/* minimise distance for perigee, maximise for apogee */
+	sign = apsis == LN_LUNAR_APOGEE ? -1.0 : 1.0;
+	JD0 = get_mean_apsis (k);
+
+	/* true apsis is within 3 days of the mean; bracket it on 0.5 day grid */
+	for (i = 0; i < 13; i++) {
+		s[i] = sign * get_lunar_dist (JD0 + (i - 6) * 0.5);
+		if (i == 0 || s[i] < s[j])
+			j = i;
+	}
+	if (j == 0)
+		j = 1;
+	else if (j == 12)
+		j = 11;
+
+	for (i = 0; i < 3; i++) {
+		x[i] = JD0 + (j + i - 7) * 0.5;
+		f[i] = s[j + i - 1];
+	}
+
+	for (i = 0; i < LUNAR_EVENT_MAX_ITER; i++) {
+		d = (x[1] - x[0]) * (f[1] - f[2]) - (x[1] - x[2]) * (f[1] - f[0]);
+		if (d == 0)
+			break;
+		JD = x[1] - 0.5 * ((x[1] - x[0]) * (x[1] - x[0]) * (f[1] - f[2])
+			- (x[1] - x[2]) * (x[1] - x[2]) * (f[1] - f[0])) / d;
+		if (JD <= x[0] || JD >= x[2])
+			break;
+		if (fabs (JD - x[1]) < LUNAR_EVENT_PRECISION) {
+			x[1] = JD;
+			f[1] = sign * get_lunar_dist (JD);
+			break;
+		}
+
+		/* keep the best three points bracketing the extreme */
+		fx = sign * get_lunar_dist (JD);
+		if (JD > x[1]) {
+			if (fx < f[1]) {
+				x[0] = x[1]; f[0] = f[1];
+				x[1] = JD; f[1] = fx;
+			} else {
+				x[2] = JD; f[2] = fx;
+			}
+		} else {
+			if (fx < f[1]) {
+				x[2] = x[1]; f[2] = f[1];
+				x[1] = JD; f[1] = fx;
+			} else {
+				x[0] = JD; f[0] = fx;
+			}
+		}
+	}
+
+	if (dist)
+		*dist = sign * f[1];
+	return x[1];
+}
+
+/*! \fn double ln_get_lunar_next_phase (double JD, int phase);
+* \param JD Julian Day
+* \param phase Phase, one of LN_LUNAR_NEW, LN_LUNAR_FIRST_QUARTER,
+* LN_LUNAR_FULL and LN_LUNAR_LAST_QUARTER
+* \return Julian Day of the next phase
+* \ingroup lunar
+*
+* Calculate time of the first principal phase of the Moon after JD. Phase
+* is the time at which the difference of apparent geocentric longitudes of
+* the Moon and the Sun equals 0, 90, 180 or 270 degrees. The mean phase of
+* Meeus equ 49.1 is refined by the secant method on the ELP 2000-82B and
+* VSOP87 longitudes; the result is within a few seconds of the true phase.
+* As with the other lunar functions, JD is in dynamical time.
+*/
+double ln_get_lunar_next_phase (double JD, int phase)
+{
+	double k, t;
+
+	k = floor ((JD - 2451550.09766) / SYNODIC_MONTH) - 1;
+	do {
+		t = get_lunar_phase_time (k + phase / 4.0, phase);
+		k++;
+	} while (t <= JD);
+
+	return t;
+}
+
+/*! \fn int ln_get_lunar_phases (double JD_start, double JD_end, struct ln_lunar_event * events, int max_events);
+* \param JD_start Start of the interval, Julian Day
+* \param JD_end End of the interval, Julian Day
+* \param events Array of max_events elements to store the phases
+* \param max_events Size of events array
+* \return Number of phases found. If it is greater than max_events, only
+* the first max_events phases were stored.
+* \ingroup lunar
+*
+* Calculate times of all principal phases of the Moon in given interval,
+* sorted by time. See ln_get_lunar_next_phase. The dist member is set to
+* the Earth - Moon distance at the phase.
+*/
+int ln_get_lunar_phases (double JD_start, double JD_end,
+	struct ln_lunar_event *events, int max_events)
+{
+	double k, t;
+	int phase, count = 0;
+
+	k = floor ((JD_start - 2451550.09766) / SYNODIC_MONTH) - 1;
+	for (;; k++) {
+		for (phase = LN_LUNAR_NEW; phase <= LN_LUNAR_LAST_QUARTER; phase++) {
+			t = get_lunar_phase_time (k + phase / 4.0, phase);
+			if (t > JD_end)
+				return count;
+			if (t < JD_start)
+				continue;
+			if (count < max_events) {
+				events[count].JD = t;
+				events[count].type = phase;
+				events[count].dist = get_lunar_dist (t);
+			}
+			count++;
+		}
+	}
+}
+
+/*! \fn double ln_get_lunar_next_apsis (double JD, int apsis, double * dist);
+* \param JD Julian Day
+* \param apsis LN_LUNAR_PERIGEE or LN_LUNAR_APOGEE
+* \param dist Pointer to store Earth - Moon distance at apsis in km, or NULL
+* \return Julian Day of the next apsis
+* \ingroup lunar
+*
+* Calculate time of the first lunar perigee or apogee after JD, i.e. time
+* of the minimum or maximum of ln_get_lunar_earth_dist. The search starts
+* at the mean apsis of Meeus equ 50.1 and the extreme is then located by
+* successive parabolic interpolation, reusing the evaluated distances.
+*/
+double ln_get_lunar_next_apsis (double JD, int apsis, double *dist)
+{
+	double k, t;
+
+	k = floor ((JD - 2451534.6698) / ANOMALISTIC_MONTH) - 1;
+	do {
+		t = get_lunar_apsis_time (k + apsis / 2.0, apsis, dist);
+		k++;
+	} while (t <= JD);
+
+	return t;
+}
+
+/*! \fn int ln_get_lunar_apsides (double JD_start, double JD_end, struct ln_lunar_event * events, int max_events);
+* \param JD_start Start of the interval, Julian Day
+* \param JD_end End of the interval, Julian Day
+* \param events Array of max_events elements to store apsides
+* \param max_events Size of events array
+* \return Number of apsides found. If it is greater than max_events, only
+* the first max_events apsides were stored.
+* \ingroup lunar
+*
+* Calculate times and distances of all lunar perigees and apogees in given
+* interval, sorted by time. See ln_get_lunar_next_apsis.
+*/
+int ln_get_lunar_apsides (double JD_start, double JD_end,
+	struct ln_lunar_event *events, int max_events)
+{
+	double k, t, dist;
+	int apsis, count = 0;
+
+	k = floor ((JD_start - 2451534.6698) / ANOMALISTIC_MONTH) - 1;
+	for (;; k++) {
+		for (apsis = LN_LUNAR_PERIGEE; apsis <= LN_LUNAR_APOGEE; apsis++) {
+			t = get_lunar_apsis_time (k + apsis / 2.0, apsis, &dist);
+			if (t > JD_end)
+				return count;
+			if (t < JD_start)
+				continue;
+			if (count < max_events) {
+				events[count].JD = t;
+				events[count].type = apsis;
+				events[count].dist = dist;
+			}
+			count++;
+		}
+	}
+}
+
 /*! \example lunar.c
  * 
  * Examples of how to use Lunar functions. 
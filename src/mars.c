@@ -25,6 +25,7 @@
 #include <libnova/solar.h>
 #include <libnova/earth.h>
 #include <libnova/transform.h>
+#include <libnova/light_time.h>
 #include <libnova/rise_set.h>
 #include <libnova/utility.h>
 
@@ -6537,38 +6538,11 @@ static const struct ln_vsop mars_radius_r5[RADIUS_R5] = {
 */ 
 void ln_get_mars_equ_coords (double JD, struct ln_equ_posn * position)
 {
-	struct ln_helio_posn h_sol, h_mars;
-	struct ln_rect_posn g_sol, g_mars;
-	double a,b,c;
-	double ra, dec, delta, diff, last, t = 0;
-	
-	/* need typdef for solar heliocentric coords */
-	ln_get_solar_geom_coords (JD, &h_sol);
-	ln_get_rect_from_helio (&h_sol, &g_sol);
-	
-	do {
-		last = t;
-		ln_get_mars_helio_coords (JD - t, &h_mars);
-		ln_get_rect_from_helio (&h_mars, &g_mars);
+	struct ln_rect_posn g_mars;
 
-		/* equ 33.10 pg 229 */
-		a = g_sol.X + g_mars.X;
-		b = g_sol.Y + g_mars.Y;
-		c = g_sol.Z + g_mars.Z;
-	
-		delta = a*a + b*b + c*c;
-		delta = sqrt (delta);
-		t = delta * 0.0057755183;
-		diff = t - last;
-	} while (diff > 0.0001 || diff < -0.0001);
-		
-	ra = atan2 (b,a);
-	dec = c / delta;
-	dec = asin (dec);
-
-	/* back to hours, degrees */
-	position->ra = ln_range_degrees(ln_rad_to_deg (ra));
-	position->dec = ln_rad_to_deg (dec);
+	/* light time corrected geocentric position, equ 33.10 pg 229 */
+	ln_get_body_light_time_geo_posn (JD, ln_get_mars_rect_helio_state, &g_mars);
+	ln_get_equ_from_rect (&g_mars, position);
 }
 	
 
@@ -6699,6 +6673,32 @@ double ln_get_mars_solar_dist (double JD)
 	return h_mars.R;
 }
 	
+/*! \fn void ln_get_mars_geom (double JD, struct ln_planet_geom * geom);
+* \param JD Julian day
+* \param geom Pointer to store geometry
+*
+* Calculate distances of Mars from the Sun and the Earth and its phase
+* angle, corrected for light time. Magnitude, illuminated fraction and
+* semidiameter of Mars are derived from the geometry.
+*/
+void ln_get_mars_geom (double JD, struct ln_planet_geom * geom)
+{
+	ln_get_body_geom (JD, ln_get_mars_rect_helio_state, geom);
+}
+
+/*! \fn double ln_get_mars_geom_magnitude (struct ln_planet_geom * geom);
+* \param geom Geometry of Mars from ln_get_mars_geom
+* \return Visible magnitude of Mars
+*
+* Calculate the visible magnitude of Mars from its geometry.
+*/
+double ln_get_mars_geom_magnitude (struct ln_planet_geom * geom)
+{
+	double r = geom->r, delta = geom->delta, i = geom->phase;
+
+	return -1.52 + 5 * log10 (r * delta) + 0.016 * i;
+}
+
 /*! \fn double ln_get_mars_magnitude (double JD);
 * \brief Calculate the visible magnitude of Mars
 * \param JD Julian Day
@@ -6708,16 +6708,10 @@ double ln_get_mars_solar_dist (double JD)
 */ 
 double ln_get_mars_magnitude (double JD)
 {
-	double delta, r, i;
-	
-	/* get distances */
-	r = ln_get_mars_solar_dist (JD);
-	delta = ln_get_mars_earth_dist (JD);
-	
-	/* get phase */
-	i = ln_get_mars_phase (JD);
-	
-	return -1.52 + 5 * log10 (r * delta) + 0.016 * i;
+	struct ln_planet_geom geom;
+
+	ln_get_mars_geom (JD, &geom);
+	return ln_get_mars_geom_magnitude (&geom);
 }
 
 /*! \fn double ln_get_mars_disk (double JD);
@@ -6730,16 +6724,10 @@ double ln_get_mars_magnitude (double JD)
 /* Chapter 41 */
 double ln_get_mars_disk (double JD)
 {
-	double r,delta,R;	
-	
-	/* get distances */
-	R = ln_get_earth_solar_dist (JD);
-	r = ln_get_mars_solar_dist (JD);
-	delta = ln_get_mars_earth_dist (JD);
-	
-	/* calc fraction angle */
-	return (((r + delta) * (r + delta)) - R * R) / (4 * r * delta);
-	
+	struct ln_planet_geom geom;
+
+	ln_get_mars_geom (JD, &geom);
+	return ln_get_planet_geom_disk (&geom);
 }
 
 /*! \fn double ln_get_mars_phase (double JD);
@@ -6752,17 +6740,10 @@ double ln_get_mars_disk (double JD)
 /* Chapter 41 */
 double ln_get_mars_phase (double JD)
 {
-	double i,r,delta,R;	
-	
-	/* get distances */
-	R = ln_get_earth_solar_dist (JD);
-	r = ln_get_mars_solar_dist (JD);
-	delta = ln_get_mars_earth_dist (JD);
+	struct ln_planet_geom geom;
 
-	/* calc phase */
-	i = (r * r + delta * delta - R * R) / (2 * r * delta);
-	i = acos (i);
-	return ln_rad_to_deg (i);
+	ln_get_mars_geom (JD, &geom);
+	return geom.phase;
 }
 
 
@@ -6792,12 +6773,24 @@ int ln_get_mars_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_t
 * given julian day.
 */
 double ln_get_mars_sdiam (double JD)
+{
+	struct ln_planet_geom geom;
+
+	ln_get_mars_geom (JD, &geom);
+	return ln_get_mars_geom_sdiam (&geom);
+}
+
+/*! \fn double ln_get_mars_geom_sdiam (struct ln_planet_geom * geom)
+* \param geom Geometry of Mars from ln_get_mars_geom
+* \return Semidiameter in arc seconds
+*
+* Calculate the semidiameter of Mars in arc seconds from its geometry.
+*/
+double ln_get_mars_geom_sdiam (struct ln_planet_geom * geom)
 {
 	double So = 4.68; /* at 1 AU */
-	double dist;
-	
-	dist = ln_get_mars_earth_dist (JD);
-	return So / dist;
+
+	return So / geom->delta;
 }
 	
 /*! \fn void ln_get_mars_rect_helio (double JD, struct ln_rect_posn * position)
@@ -6815,6 +6808,63 @@ void ln_get_mars_rect_helio (double JD, struct ln_rect_posn * position)
 	ln_get_rect_from_helio (&mars, position);
 }
 
+/*! \fn void ln_get_mars_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \param JD Julian day.
+* \param posn pointer to return position
+* \param vel pointer to return velocity
+*
+* Calculate Mars rectangular heliocentric coordinates and velocity for the
+* given Julian day. Velocity is obtained by differentiating the VSOP87
+* series term by term. Coordinates are in AU, velocity in AU per day.
+*/
+void ln_get_mars_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+{
+	double t;
+	double L[6], B[6], R[6];
+	double dL[6], dB[6], dR[6];
+	struct ln_helio_posn position, rate;
+
+	/* get julian ephemeris day */
+	t = (JD - 2451545.0) / 365250.0;
+
+	/* calc L series and derivatives */
+	L[0] = ln_calc_series_dot (mars_longitude_l0, LONG_L0, t, &dL[0]);
+	L[1] = ln_calc_series_dot (mars_longitude_l1, LONG_L1, t, &dL[1]);
+	L[2] = ln_calc_series_dot (mars_longitude_l2, LONG_L2, t, &dL[2]);
+	L[3] = ln_calc_series_dot (mars_longitude_l3, LONG_L3, t, &dL[3]);
+	L[4] = ln_calc_series_dot (mars_longitude_l4, LONG_L4, t, &dL[4]);
+	L[5] = ln_calc_series_dot (mars_longitude_l5, LONG_L5, t, &dL[5]);
+	position.L = ln_calc_series_poly (L, dL, 6, t, &rate.L);
+
+	/* calc B series and derivatives */
+	B[0] = ln_calc_series_dot (mars_latitude_b0, LAT_B0, t, &dB[0]);
+	B[1] = ln_calc_series_dot (mars_latitude_b1, LAT_B1, t, &dB[1]);
+	B[2] = ln_calc_series_dot (mars_latitude_b2, LAT_B2, t, &dB[2]);
+	B[3] = ln_calc_series_dot (mars_latitude_b3, LAT_B3, t, &dB[3]);
+	B[4] = ln_calc_series_dot (mars_latitude_b4, LAT_B4, t, &dB[4]);
+	B[5] = ln_calc_series_dot (mars_latitude_b5, LAT_B5, t, &dB[5]);
+	position.B = ln_calc_series_poly (B, dB, 6, t, &rate.B);
+
+	/* calc R series and derivatives */
+	R[0] = ln_calc_series_dot (mars_radius_r0, RADIUS_R0, t, &dR[0]);
+	R[1] = ln_calc_series_dot (mars_radius_r1, RADIUS_R1, t, &dR[1]);
+	R[2] = ln_calc_series_dot (mars_radius_r2, RADIUS_R2, t, &dR[2]);
+	R[3] = ln_calc_series_dot (mars_radius_r3, RADIUS_R3, t, &dR[3]);
+	R[4] = ln_calc_series_dot (mars_radius_r4, RADIUS_R4, t, &dR[4]);
+	R[5] = ln_calc_series_dot (mars_radius_r5, RADIUS_R5, t, &dR[5]);
+	position.R = ln_calc_series_poly (R, dR, 6, t, &rate.R);
+
+	/* change to degrees in correct quadrant, rates to degrees per day */
+	position.L = ln_range_degrees(ln_rad_to_deg(position.L));
+	position.B = ln_rad_to_deg(position.B);
+	rate.L = ln_rad_to_deg(rate.L) / 365250.0;
+	rate.B = ln_rad_to_deg(rate.B) / 365250.0;
+	rate.R /= 365250.0;
+
+	/* change to fk5 reference frame and rectangular coordinates */
+	ln_vsop87_rect_state (&position, &rate, JD, posn, vel);
+}
+
 /*! \example mars.c
  * 
  * Examples of how to use planetary functions. 
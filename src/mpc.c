@@ -0,0 +1,326 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <libnova/mpc.h>
+#include <libnova/orbit.h>
+#include <libnova/julian_day.h>
+
+/* minimal length of MPCORB line, up to semi major axis */
+#define MPCORB_LEN		103
+
+/* minimal length of CometEls line, up to inclination */
+#define COMETELS_LEN	79
+
+/* Read fixed width decimal number. Blank field is an error unless
+ * blank_ok is set, then value is 0. strtod is avoided as it depends on
+ * locale and needs a terminated string. */
+static int get_field (const char *p, int width, int blank_ok, double *value)
+{
+	double v = 0, scale = 1;
+	int i = 0, sign = 1, digits = 0, point = 0;
+
+	while (i < width && p[i] == ' ')
+		i++;
+	if (i < width && (p[i] == '-' || p[i] == '+')) {
+		if (p[i] == '-')
+			sign = -1;
+		i++;
+	}
+	for (; i < width && p[i] != ' '; i++) {
+		if (p[i] == '.' && !point) {
+			point = 1;
+		} else if (p[i] >= '0' && p[i] <= '9') {
+			v = v * 10 + (p[i] - '0');
+			if (point)
+				scale *= 10;
+			digits++;
+		} else {
+			return -1;
+		}
+	}
+	/* only trailing blanks are allowed */
+	for (; i < width; i++)
+		if (p[i] != ' ')
+			return -1;
+
+	if (!digits) {
+		if (!blank_ok || point)
+			return -1;
+	}
+	*value = sign * v / scale;
+	return 0;
+}
+
+static int is_blank (const char *p, int width)
+{
+	int i;
+
+	for (i = 0; i < width; i++)
+		if (p[i] != ' ')
+			return 0;
+	return 1;
+}
+
+/* copy designation without spaces */
+static void get_desig (const char *p, int width, char *desig)
+{
+	int i, j = 0;
+
+	for (i = 0; i < width && j < 15; i++)
+		if (p[i] != ' ')
+			desig[j++] = p[i];
+	desig[j] = 0;
+}
+
+/* length of line starting at p, without line terminator */
+static long get_line_len (const char *p, long size)
+{
+	const char *end = memchr (p, '\n', size);
+	long len = end ? end - p : size;
+
+	if (len > 0 && p[len - 1] == '\r')
+		len--;
+	return len;
+}
+
+static int compare_desig (const void *a, const void *b)
+{
+	return strcmp (((const struct ln_mpc_desig *) a)->desig,
+		((const struct ln_mpc_desig *) b)->desig);
+}
+
+/*! \fn int ln_get_ell_orbit_from_mpcorb (const char * line, int len, struct ln_ell_orbit * orbit, struct ln_mag_params * params);
+* \param line Line of MPCORB file, need not be terminated
+* \param len Length of line
+* \param orbit Pointer to store orbital elements
+* \param params Pointer to store H and G, or NULL
+* \return 0 on success, -1 if the line does not contain orbital elements
+*
+* Read orbit of minor planet from line in the MPCORB.DAT format, see
+* http://www.minorplanetcenter.net/iau/info/MPOrbitFormat.html. Time of
+* perihelion is calculated from mean anomaly at epoch. Header lines and
+* lines with malformed fields are rejected.
+*/
+int ln_get_ell_orbit_from_mpcorb (const char *line, int len,
+	struct ln_ell_orbit *orbit, struct ln_mag_params *params)
+{
+	struct ln_date date;
+	char epoch[6];
+	double H, G, M;
+
+	if (len < MPCORB_LEN || line[0] == ' ')
+		return -1;
+
+	if (get_field (line + 8, 5, 1, &H) || get_field (line + 14, 5, 1, &G) ||
+		get_field (line + 26, 9, 0, &M) || get_field (line + 37, 9, 0, &orbit->w) ||
+		get_field (line + 48, 9, 0, &orbit->omega) ||
+		get_field (line + 59, 9, 0, &orbit->i) ||
+		get_field (line + 70, 9, 0, &orbit->e) ||
+		get_field (line + 80, 11, 0, &orbit->n) ||
+		get_field (line + 92, 11, 0, &orbit->a))
+		return -1;
+
+	memcpy (epoch, line + 20, 5);
+	epoch[5] = 0;
+	if (ln_get_date_from_mpc (&date, epoch) || orbit->n <= 0)
+		return -1;
+
+	orbit->JD = ln_get_julian_day (&date) - M / orbit->n;
+
+	if (params) {
+		params->type = LN_MAG_ASTEROID;
+		params->H = H;
+		/* MPC uses 0.15 when G is not known */
+		params->G = is_blank (line + 14, 5) ? 0.15 : G;
+		params->A = 0;
+	}
+	return 0;
+}
+
+/*! \fn int ln_get_hyp_orbit_from_cometels (const char * line, int len, struct ln_hyp_orbit * orbit, struct ln_mag_params * params);
+* \param line Line of CometEls file, need not be terminated
+* \param len Length of line
+* \param orbit Pointer to store orbital elements
+* \param params Pointer to store g and k, or NULL
+* \return 0 on success, -1 if the line does not contain orbital elements
+*
+* Read orbit of comet from line in the CometEls.txt format, see
+* http://www.minorplanetcenter.net/iau/info/CometOrbitFormat.html. Orbits
+* of all eccentricities are returned in struct ln_hyp_orbit, which can be
+* passed to ln_prep_univ_orbit. The MPC slope parameter is multiplied by
+* 2.5 to give the comet constant k of ln_get_ell_comet_mag.
+*/
+int ln_get_hyp_orbit_from_cometels (const char *line, int len,
+	struct ln_hyp_orbit *orbit, struct ln_mag_params *params)
+{
+	struct ln_date date;
+	double year, month, day, H = 0, G = 0;
+
+	if (len < COMETELS_LEN)
+		return -1;
+
+	if (get_field (line + 14, 4, 0, &year) ||
+		get_field (line + 19, 2, 0, &month) ||
+		get_field (line + 22, 7, 0, &day) ||
+		get_field (line + 30, 9, 0, &orbit->q) ||
+		get_field (line + 41, 8, 0, &orbit->e) ||
+		get_field (line + 51, 8, 0, &orbit->w) ||
+		get_field (line + 61, 8, 0, &orbit->omega) ||
+		get_field (line + 71, 8, 0, &orbit->i))
+		return -1;
+
+	/* magnitude parameters are optional */
+	if (len >= 100 && (get_field (line + 91, 4, 1, &H) ||
+		get_field (line + 96, 4, 1, &G)))
+		return -1;
+
+	date.years = year;
+	date.months = month;
+	date.days = day;
+	date.hours = 0;
+	date.minutes = 0;
+	date.seconds = 0;
+	orbit->JD = ln_get_julian_day (&date) + day - date.days;
+
+	if (params) {
+		params->type = LN_MAG_COMET;
+		params->H = H;
+		params->G = 2.5 * G;
+		params->A = 0;
+	}
+	return 0;
+}
+
+/*! \fn int ln_get_mpcorb_orbits (const char * buffer, long size, struct ln_prep_orbit * prep, struct ln_mag_params * params, struct ln_mpc_desig * desig, int max);
+* \param buffer Content of MPCORB file
+* \param size Size of buffer in bytes
+* \param prep Array of max elements to store prepared orbits
+* \param params Array of max elements to store H and G, or NULL
+* \param desig Array of max elements to store designations, or NULL
+* \param max Maximal number of orbits
+* \return Number of orbits read
+*
+* Read all minor planets from MPCORB.DAT file, or any file with lines in
+* the same format. Lines which do not contain orbital elements, such as
+* the file header, are skipped. Orbits are prepared for
+* ln_get_prep_univ_equ_coords and ln_get_prep_orbits_mag. Designation
+* entries get the index of the orbit in prep, use ln_sort_mpc_desig to
+* sort them for ln_find_mpc_desig. When several files are read into one
+* catalogue, the caller offsets the indices.
+*/
+int ln_get_mpcorb_orbits (const char *buffer, long size,
+	struct ln_prep_orbit *prep, struct ln_mag_params *params,
+	struct ln_mpc_desig *desig, int max)
+{
+	struct ln_ell_orbit orbit;
+	long len;
+	int count = 0;
+
+	while (size > 0 && count < max) {
+		len = get_line_len (buffer, size);
+
+		if (!ln_get_ell_orbit_from_mpcorb (buffer, len, &orbit,
+			params ? params + count : NULL)) {
+			ln_prep_ell_orbit (&orbit, prep + count);
+			if (desig) {
+				get_desig (buffer, 7, desig[count].desig);
+				desig[count].index = count;
+			}
+			count++;
+		}
+
+		/* skip line terminator */
+		while (len < size && (buffer[len] == '\r' || buffer[len] == '\n'))
+			len++;
+		buffer += len;
+		size -= len;
+	}
+	return count;
+}
+
+/*! \fn int ln_get_cometels_orbits (const char * buffer, long size, struct ln_prep_orbit * prep, struct ln_mag_params * params, struct ln_mpc_desig * desig, int max);
+* \param buffer Content of CometEls file
+* \param size Size of buffer in bytes
+* \param prep Array of max elements to store prepared orbits
+* \param params Array of max elements to store g and k, or NULL
+* \param desig Array of max elements to store designations, or NULL
+* \param max Maximal number of orbits
+* \return Number of orbits read
+*
+* Read all comets from CometEls.txt file, see ln_get_mpcorb_orbits. The
+* designation is formed from the periodic comet number, orbit type and
+* packed provisional designation.
+*/
+int ln_get_cometels_orbits (const char *buffer, long size,
+	struct ln_prep_orbit *prep, struct ln_mag_params *params,
+	struct ln_mpc_desig *desig, int max)
+{
+	struct ln_hyp_orbit orbit;
+	long len;
+	int count = 0;
+
+	while (size > 0 && count < max) {
+		len = get_line_len (buffer, size);
+
+		if (!ln_get_hyp_orbit_from_cometels (buffer, len, &orbit,
+			params ? params + count : NULL)) {
+			ln_prep_univ_orbit (&orbit, prep + count);
+			if (desig) {
+				get_desig (buffer, 12, desig[count].desig);
+				desig[count].index = count;
+			}
+			count++;
+		}
+
+		while (len < size && (buffer[len] == '\r' || buffer[len] == '\n'))
+			len++;
+		buffer += len;
+		size -= len;
+	}
+	return count;
+}
+
+/*! \fn void ln_sort_mpc_desig (struct ln_mpc_desig * desig, int count);
+* \param desig Array of designations
+* \param count Number of designations
+*
+* Sort catalogue index by packed designation, for ln_find_mpc_desig.
+*/
+void ln_sort_mpc_desig (struct ln_mpc_desig *desig, int count)
+{
+	qsort (desig, count, sizeof (struct ln_mpc_desig), compare_desig);
+}
+
+/*! \fn int ln_find_mpc_desig (struct ln_mpc_desig * desig, int count, const char * packed);
+* \param desig Array of designations sorted by ln_sort_mpc_desig
+* \param count Number of designations
+* \param packed Packed designation, spaces are ignored
+* \return Index of body in catalogue, -1 if not found
+*
+* Find body in catalogue by binary search in sorted index.
+*/
+int ln_find_mpc_desig (struct ln_mpc_desig *desig, int count,
+	const char *packed)
+{
+	struct ln_mpc_desig key, *found;
+
+	get_desig (packed, (int) strlen (packed), key.desig);
+	found = bsearch (&key, desig, count, sizeof (struct ln_mpc_desig),
+		compare_desig);
+	return found ? found->index : -1;
+}
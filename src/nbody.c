@@ -0,0 +1,348 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <libnova/nbody.h>
+#include <libnova/orbit.h>
+#include <libnova/mercury.h>
+#include <libnova/venus.h>
+#include <libnova/earth.h>
+#include <libnova/mars.h>
+#include <libnova/jupiter.h>
+#include <libnova/saturn.h>
+#include <libnova/uranus.h>
+#include <libnova/neptune.h>
+#include <libnova/utility.h>
+
+#define GAUS_GRAV	0.01720209895	// Gaussian gravitational constant k
+
+/* relative and absolute tolerance of integrator */
+#define NBODY_TOL	1e-12
+
+/* maximal number of integrator steps in one call */
+#define NBODY_MAX_STEPS	1000000
+
+static void (*get_planet_state[LN_NBODY_PLANETS]) (double JD,
+	struct ln_rect_posn * posn, struct ln_rect_posn * vel) = {
+	ln_get_mercury_rect_helio_state,
+	ln_get_venus_rect_helio_state,
+	ln_get_earth_rect_helio_state,
+	ln_get_mars_rect_helio_state,
+	ln_get_jupiter_rect_helio_state,
+	ln_get_saturn_rect_helio_state,
+	ln_get_uranus_rect_helio_state,
+	ln_get_neptune_rect_helio_state,
+};
+
+/* reciprocal planet masses in solar masses, Earth includes the Moon */
+static const double planet_mass[LN_NBODY_PLANETS] = {
+	6023600.0,
+	408523.71,
+	328900.56,
+	3098708.0,
+	1047.3486,
+	3497.898,
+	22902.98,
+	19412.24,
+};
+
+/* Dormand-Prince 5(4) coefficients */
+static const double dp_c[7] = {0, 1.0/5, 3.0/10, 4.0/5, 8.0/9, 1.0, 1.0};
+static const double dp_a[7][6] = {
+	{0},
+	{1.0/5},
+	{3.0/40, 9.0/40},
+	{44.0/45, -56.0/15, 32.0/9},
+	{19372.0/6561, -25360.0/2187, 64448.0/6561, -212.0/729},
+	{9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656},
+	{35.0/384, 0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84},
+};
+/* difference of 5th and 4th order weights */
+static const double dp_e[7] = {71.0/57600, 0, -71.0/16695, 71.0/1920,
+	-17253.0/339200, 22.0/525, -1.0/40};
+
+/*! \fn int ln_get_nbody_cache_nodes (double JD_start, double JD_end, double step);
+* \param JD_start Start of the interval
+* \param JD_end End of the interval
+* \param step Spacing of nodes in days
+* \return Number of nodes
+*
+* Calculate number of nodes of planet cache starting at JD_start and
+* covering the interval up to JD_end.
+*/
+int ln_get_nbody_cache_nodes (double JD_start, double JD_end, double step)
+{
+	return (int) ceil ((JD_end - JD_start) / step) + 1;
+}
+
+/*! \fn void ln_prep_nbody_cache (double JD, double step, int nodes, struct ln_rect_posn * posn, struct ln_rect_posn * vel, struct ln_nbody_cache * cache);
+* \param JD Time of the first node
+* \param step Spacing of nodes in days
+* \param nodes Number of nodes, at least 2
+* \param posn Array of nodes * LN_NBODY_PLANETS elements to store positions
+* \param vel Array of nodes * LN_NBODY_PLANETS elements to store velocities
+* \param cache Pointer to store the cache
+*
+* Calculate positions and velocities of planets Mercury to Neptune at
+* cache nodes and set their gravitational parameters. Planets can be
+* excluded from perturbations by setting their GM to zero. Positions
+* between nodes are interpolated by cubic Hermite polynomials, so the step
+* of LN_NBODY_DEFAULT_STEP keeps interpolation errors far below the
+* accuracy of VSOP87.
+*
+* Cache is only read during integration, so it can be shared by any number
+* of bodies and threads. It does not need to be saved with checkpoints,
+* calling this function with the same arguments recreates it exactly.
+*/
+void ln_prep_nbody_cache (double JD, double step, int nodes,
+	struct ln_rect_posn *posn, struct ln_rect_posn *vel,
+	struct ln_nbody_cache *cache)
+{
+	int i, j;
+
+	cache->JD = JD;
+	cache->step = step;
+	cache->nodes = nodes;
+	cache->posn = posn;
+	cache->vel = vel;
+
+	for (j = 0; j < LN_NBODY_PLANETS; j++)
+		cache->GM[j] = GAUS_GRAV * GAUS_GRAV / planet_mass[j];
+
+	for (i = 0; i < nodes; i++) {
+		for (j = 0; j < LN_NBODY_PLANETS; j++)
+			get_planet_state[j] (JD + i * step, posn + i * LN_NBODY_PLANETS + j,
+				vel + i * LN_NBODY_PLANETS + j);
+	}
+}
+
+/*! \fn void ln_get_nbody_cache_planets (struct ln_nbody_cache * cache, double JD, struct ln_rect_posn * posn);
+* \param cache Planet cache
+* \param JD Julian day within the cache
+* \param posn Array of LN_NBODY_PLANETS elements to store positions
+*
+* Interpolate heliocentric positions of perturbing planets from cache nodes.
+*/
+void ln_get_nbody_cache_planets (struct ln_nbody_cache *cache, double JD,
+	struct ln_rect_posn *posn)
+{
+	struct ln_rect_posn *p0, *p1, *v0, *v1;
+	double s, s2, s3, h00, h10, h01, h11;
+	int i, j;
+
+	s = (JD - cache->JD) / cache->step;
+	i = (int) floor (s);
+	if (i < 0)
+		i = 0;
+	if (i > cache->nodes - 2)
+		i = cache->nodes - 2;
+	s -= i;
+
+	/* cubic Hermite basis, velocity terms scaled by step */
+	s2 = s * s;
+	s3 = s2 * s;
+	h00 = 2 * s3 - 3 * s2 + 1;
+	h10 = (s3 - 2 * s2 + s) * cache->step;
+	h01 = 3 * s2 - 2 * s3;
+	h11 = (s3 - s2) * cache->step;
+
+	p0 = cache->posn + i * LN_NBODY_PLANETS;
+	v0 = cache->vel + i * LN_NBODY_PLANETS;
+	p1 = p0 + LN_NBODY_PLANETS;
+	v1 = v0 + LN_NBODY_PLANETS;
+
+	for (j = 0; j < LN_NBODY_PLANETS; j++) {
+		posn[j].X = h00 * p0[j].X + h10 * v0[j].X + h01 * p1[j].X + h11 * v1[j].X;
+		posn[j].Y = h00 * p0[j].Y + h10 * v0[j].Y + h01 * p1[j].Y + h11 * v1[j].Y;
+		posn[j].Z = h00 * p0[j].Z + h10 * v0[j].Z + h01 * p1[j].Z + h11 * v1[j].Z;
+	}
+}
+
+/*! \fn void ln_prep_nbody_state (struct ln_prep_orbit * prep, double JD, struct ln_nbody_state * state);
+* \param prep Prepared osculating orbit
+* \param JD Julian day of the state, usually epoch of osculation
+* \param state Pointer to store the state
+*
+* Set state of integrated body from its osculating orbit.
+*/
+void ln_prep_nbody_state (struct ln_prep_orbit *prep, double JD,
+	struct ln_nbody_state *state)
+{
+	state->JD = JD;
+	state->step = 0;
+	ln_get_prep_helio_rect_state (prep, JD, &state->posn, &state->vel);
+}
+
+/* heliocentric equations of motion, y is position and velocity */
+static void get_derivs (struct ln_nbody_cache *cache, double JD,
+	const double *y, double *dy)
+{
+	struct ln_rect_posn planets[LN_NBODY_PLANETS];
+	double r, dx, dyy, dz, d, p, f;
+	int j;
+
+	ln_get_nbody_cache_planets (cache, JD, planets);
+
+	r = sqrt (y[0] * y[0] + y[1] * y[1] + y[2] * y[2]);
+	f = -GAUS_GRAV * GAUS_GRAV / (r * r * r);
+	dy[0] = y[3];
+	dy[1] = y[4];
+	dy[2] = y[5];
+	dy[3] = f * y[0];
+	dy[4] = f * y[1];
+	dy[5] = f * y[2];
+
+	/* direct and indirect perturbation of each planet */
+	for (j = 0; j < LN_NBODY_PLANETS; j++) {
+		if (cache->GM[j] == 0)
+			continue;
+		dx = planets[j].X - y[0];
+		dyy = planets[j].Y - y[1];
+		dz = planets[j].Z - y[2];
+		d = sqrt (dx * dx + dyy * dyy + dz * dz);
+		d = cache->GM[j] / (d * d * d);
+		p = sqrt (planets[j].X * planets[j].X + planets[j].Y * planets[j].Y +
+			planets[j].Z * planets[j].Z);
+		p = cache->GM[j] / (p * p * p);
+		dy[3] += d * dx - p * planets[j].X;
+		dy[4] += d * dyy - p * planets[j].Y;
+		dy[5] += d * dz - p * planets[j].Z;
+	}
+}
+
+/*! \fn int ln_nbody_integrate (struct ln_nbody_cache * cache, struct ln_nbody_state * state, double JD);
+* \param cache Planet cache covering state->JD and JD
+* \param state State of the body, updated to JD
+* \param JD Julian day to integrate to, may be before state->JD
+* \return 0 on success, -1 if JD is not covered by cache or integration fails
+*
+* Integrate heliocentric motion of a massless body perturbed by planets in
+* cache. The step size is adapted to keep local error about 1e-12 AU and
+* the proposed next step is stored in state, so integration resumed from a
+* saved copy of state gives exactly the same results. The state is not
+* modified when integration fails.
+*/
+int ln_nbody_integrate (struct ln_nbody_cache *cache,
+	struct ln_nbody_state *state, double JD)
+{
+	double y[6], yt[6], yn[6], k[7][6];
+	double t, h, hs, dir, err, sc, scale, fac, JD_end;
+	int i, j, l, last, steps;
+
+	JD_end = cache->JD + (cache->nodes - 1) * cache->step;
+	if (state->JD < cache->JD || state->JD > JD_end ||
+		JD < cache->JD || JD > JD_end)
+		return -1;
+
+	y[0] = state->posn.X;
+	y[1] = state->posn.Y;
+	y[2] = state->posn.Z;
+	y[3] = state->vel.X;
+	y[4] = state->vel.Y;
+	y[5] = state->vel.Z;
+	t = state->JD;
+	dir = JD < t ? -1.0 : 1.0;
+	h = fabs (state->step);
+	if (h == 0)
+		h = 1.0;
+
+	for (steps = 0; t != JD; steps++) {
+		if (steps > NBODY_MAX_STEPS || t + dir * h == t)
+			return -1;
+
+		/* do not step over the end */
+		hs = h;
+		last = hs >= dir * (JD - t);
+		if (last)
+			hs = dir * (JD - t);
+
+		for (i = 0; i < 7; i++) {
+			for (l = 0; l < 6; l++) {
+				yt[l] = y[l];
+				for (j = 0; j < i; j++)
+					yt[l] += dir * hs * dp_a[i][j] * k[j][l];
+			}
+			get_derivs (cache, t + dir * hs * dp_c[i], yt, k[i]);
+		}
+
+		/* 7th stage is evaluated at the 5th order solution */
+		err = 0;
+		for (l = 0; l < 6; l++) {
+			yn[l] = yt[l];
+			for (i = 0, sc = 0; i < 7; i++)
+				sc += dp_e[i] * k[i][l];
+			scale = fabs (y[l]) > fabs (yn[l]) ? fabs (y[l]) : fabs (yn[l]);
+			sc = fabs (hs * sc) / (NBODY_TOL * (1.0 + scale));
+			if (sc > err)
+				err = sc;
+		}
+
+		fac = err > 0 ? 0.9 * pow (err, -0.2) : 5.0;
+		if (fac > 5.0)
+			fac = 5.0;
+		if (fac < 0.2)
+			fac = 0.2;
+
+		if (err > 1.0) {
+			h = hs * fac;
+			continue;
+		}
+
+		t = last ? JD : t + dir * hs;
+		for (l = 0; l < 6; l++)
+			y[l] = yn[l];
+		/* shortened last step says little about the next one */
+		if (!last || hs * fac < h)
+			h = hs * fac;
+	}
+
+	state->step = h;
+	state->JD = JD;
+	state->posn.X = y[0];
+	state->posn.Y = y[1];
+	state->posn.Z = y[2];
+	state->vel.X = y[3];
+	state->vel.Y = y[4];
+	state->vel.Z = y[5];
+	return 0;
+}
+
+/*! \fn int ln_nbody_integrate_bodies (struct ln_nbody_cache * cache, struct ln_nbody_state * states, int count, double JD);
+* \param cache Planet cache covering JD and times of all states
+* \param states Array of count states, updated to JD
+* \param count Number of bodies
+* \param JD Julian day to integrate to
+* \return Number of bodies which could not be integrated
+*
+* Integrate motion of many bodies with one planet cache. When the library
+* is built with OpenMP, bodies are distributed among threads. Each body is
+* integrated independently, so results do not depend on number of threads.
+*/
+int ln_nbody_integrate_bodies (struct ln_nbody_cache *cache,
+	struct ln_nbody_state *states, int count, double JD)
+{
+	int i, failed = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:failed) schedule(dynamic)
+#endif
+	for (i = 0; i < count; i++) {
+		if (ln_nbody_integrate (cache, states + i, JD))
+			failed++;
+	}
+
+	return failed;
+}
@@ -222,6 +222,8 @@ void ln_get_nutation (double JD, struct ln_nutation * nutation)
 		O = ln_deg_to_rad (O);
 
 		/* calc sum of terms in table 21A */
+		c_longitude = 0;
+		c_obliquity = 0;
 		for (i=0; i< TERMS; i++) {
 			/* calc coefficients of sine and cosine */
 			coeff_sine = (coefficients[i].longitude1 + (coefficients[i].longitude2 * T));
@@ -0,0 +1,127 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+
+#include <math.h>
+#include <libnova/observer.h>
+#include <libnova/sidereal_time.h>
+#include <libnova/utility.h>
+
+/* equatorial radius of the Earth in AU */
+#define EARTH_RADIUS	(6378.14 / 149597870.0)
+
+/* rotation rate of the Earth in radians per day, from the rate of mean
+ * sidereal time */
+#define EARTH_ROTATION	(2.0 * M_PI * 360.98564736629 / 360.0)
+
+/*! \fn void ln_get_observer_itrs_posn (struct ln_topo_observer * topo, struct ln_rect_posn * posn)
+* \param topo Observer prepared by ln_prep_topo_observer
+* \param posn Pointer to store position in AU
+*
+* Calculate the position of the observer in the terrestrial frame rotating
+* with the Earth, X towards longitude 0, Z towards the north pole. Polar
+* motion is ignored.
+*/
+void ln_get_observer_itrs_posn (struct ln_topo_observer * topo, struct ln_rect_posn * posn)
+{
+	double lng;
+
+	lng = ln_deg_to_rad (topo->lng);
+	posn->X = EARTH_RADIUS * topo->ro_cos * cos (lng);
+	posn->Y = EARTH_RADIUS * topo->ro_cos * sin (lng);
+	posn->Z = EARTH_RADIUS * topo->ro_sin;
+}
+
+/* position and velocity at local apparent sidereal time in hours */
+static void get_state (struct ln_topo_observer * topo, double sidereal,
+	struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+{
+	double theta, r;
+
+	theta = sidereal * M_PI / 12.0;
+	r = EARTH_RADIUS * topo->ro_cos;
+
+	posn->X = r * cos (theta);
+	posn->Y = r * sin (theta);
+	posn->Z = EARTH_RADIUS * topo->ro_sin;
+
+	vel->X = -EARTH_ROTATION * posn->Y;
+	vel->Y = EARTH_ROTATION * posn->X;
+	vel->Z = 0;
+}
+
+/*! \fn void ln_get_observer_rect_state (struct ln_topo_observer * topo, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \param topo Observer prepared by ln_prep_topo_observer
+* \param JD Julian day
+* \param posn Pointer to store geocentric position in AU
+* \param vel Pointer to store geocentric velocity in AU per day
+*
+* Calculate geocentric position and velocity of the observer in the
+* equatorial frame of the true equator and equinox of date, the frame of
+* apparent coordinates and of ln_get_parallax. The Earth is rotated by
+* apparent sidereal time; polar motion is ignored. Velocity is due to the
+* rotation of the Earth, as needed for diurnal aberration and topocentric
+* Doppler corrections.
+*/
+void ln_get_observer_rect_state (struct ln_topo_observer * topo, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+{
+	get_state (topo, ln_get_apparent_sidereal_time (JD) + topo->lng / 15.0, posn, vel);
+}
+
+/*! \fn void ln_prep_observer_state (struct ln_topo_observer * topo, double JD, double step, struct ln_observer_state * state)
+* \param topo Observer prepared by ln_prep_topo_observer
+* \param JD Julian day of the first state
+* \param step Time step in days
+* \param state Pointer to store observer state
+*
+* Prepare observer state for a series of equally spaced times, see
+* ln_next_observer_state. The state at JD is the same as of
+* ln_get_observer_rect_state.
+*/
+void ln_prep_observer_state (struct ln_topo_observer * topo, double JD, double step, struct ln_observer_state * state)
+{
+	state->JD = JD;
+	state->JD_start = JD;
+	state->steps = 0;
+	state->step = step;
+	state->cos_step = cos (EARTH_ROTATION * step);
+	state->sin_step = sin (EARTH_ROTATION * step);
+	ln_get_observer_rect_state (topo, JD, &state->posn, &state->vel);
+}
+
+/*! \fn void ln_next_observer_state (struct ln_observer_state * state)
+* \param state Observer state from ln_prep_observer_state
+*
+* Advance observer state by one time step. Position and velocity are
+* rotated about the polar axis by a precomputed angle, without
+* trigonometric functions. Changes of nutation are neglected, so prepare
+* the state again once per day or so.
+*/
+void ln_next_observer_state (struct ln_observer_state * state)
+{
+	double X;
+
+	X = state->posn.X;
+	state->posn.X = X * state->cos_step - state->posn.Y * state->sin_step;
+	state->posn.Y = X * state->sin_step + state->posn.Y * state->cos_step;
+
+	state->vel.X = -EARTH_ROTATION * state->posn.Y;
+	state->vel.Y = EARTH_ROTATION * state->posn.X;
+
+	/* steps are too small to be added to JD repeatedly */
+	state->steps++;
+	state->JD = state->JD_start + state->steps * state->step;
+}
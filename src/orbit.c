@@ -0,0 +1,672 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <libnova/orbit.h>
+#include <libnova/elliptic_motion.h>
+#include <libnova/parabolic_motion.h>
+#include <libnova/hyperbolic_motion.h>
+#include <libnova/asteroid.h>
+#include <libnova/light_time.h>
+#include <libnova/earth.h>
+#include <libnova/transform.h>
+#include <libnova/utility.h>
+
+#define GAUS_GRAV	0.01720209895	// Gaussian gravitational constant k
+
+/* orbits solved together by ln_solve_kepler_batch */
+#define ORBITS_BLOCK	64
+
+/* orbits processed by one thread at once */
+#define ORBITS_CHUNK	4096
+
+/* maximal number of Laguerre-Conway iterations of universal Kepler equation */
+#define UNIV_ITER	30
+
+/* Stumpff functions c2 (z) and c3 (z), series near z = 0 where the closed
+   forms lose precision */
+static void get_stumpff (double z, double *c2, double *c3)
+{
+	double s;
+
+	if (fabs (z) < 0.1) {
+		*c2 = (1 - z / 12 * (1 - z / 30 * (1 - z / 56 * (1 - z / 90 * (1 - z / 132))))) / 2;
+		*c3 = (1 - z / 20 * (1 - z / 42 * (1 - z / 72 * (1 - z / 110 * (1 - z / 156))))) / 6;
+	} else if (z > 0) {
+		s = sqrt (z);
+		*c2 = (1 - cos (s)) / z;
+		*c3 = (s - sin (s)) / (z * s);
+	} else {
+		s = sqrt (-z);
+		*c2 = (cosh (s) - 1) / -z;
+		*c3 = (sinh (s) - s) / (-z * s);
+	}
+}
+
+/* Solve q x + e x^3 c3 (alpha x^2) = k t for the universal anomaly x,
+   alpha = (1 - e) / q. Derivative of left side is the radius vector, so
+   the Laguerre-Conway iteration converges from any start. */
+static double solve_universal (double q, double e, double k, double t,
+	double *c2, double *c3)
+{
+	double alpha, tau, period, x, z, c, W, Y, F, dF, ddF, dx;
+	int i;
+
+	alpha = (1.0 - e) / q;
+	tau = k * t;
+
+	/* only the last revolution of elliptic orbit is needed */
+	if (alpha > 0) {
+		period = 2.0 * M_PI / (alpha * sqrt (alpha));
+		tau = fmod (tau, period);
+		if (tau > period / 2)
+			tau -= period;
+		else if (tau < -period / 2)
+			tau += period;
+	}
+
+	/* start with solution for c3 = 1/6, which is exact for parabola */
+	if (e < 1e-8) {
+		x = tau / q;
+	} else {
+		c = 2.0 * q / e;
+		W = 3.0 * tau / e;
+		Y = cbrt (W + sqrt (W * W + c * c * c));
+		x = 2.0 * W / (Y * Y + c + c * c / (Y * Y));
+	}
+
+	for (i = 0; i < UNIV_ITER; i++) {
+		z = alpha * x * x;
+		get_stumpff (z, c2, c3);
+		F = q * x + e * x * x * x * *c3 - tau;
+		dF = q + e * x * x * *c2;
+		ddF = e * x * (1.0 - z * *c3);
+		dx = 5.0 * F / (dF + 2.0 * sqrt (fabs (4.0 * dF * dF - 5.0 * F * ddF)));
+		x -= dx;
+		if (fabs (dx) <= 1e-15 * fabs (x))
+			break;
+	}
+
+	get_stumpff (alpha * x * x, c2, c3);
+	return x;
+}
+
+/* position and velocity in orbital plane from universal anomaly, x towards
+   perihelion; dX / dt = k / r */
+static void get_universal_plane_state (double q, double e, double k, double t,
+	double *x, double *y, double *vx, double *vy)
+{
+	double X, z, c2, c3, h, dX;
+
+	X = solve_universal (q, e, k, t, &c2, &c3);
+	z = (1.0 - e) / q * X * X;
+	h = sqrt (q * (1.0 + e));
+	dX = k / (q + e * X * X * c2);
+
+	*x = q - X * X * c2;
+	*y = X * (1.0 - z * c3) * h;
+	*vx = -X * (1.0 - z * c3) * dX;
+	*vy = (1.0 - z * c2) * h * dX;
+}
+
+/* orientation of the orbital plane, equ 33.7 and 33.8 with w added */
+static void prep_orbit_plane (double i, double w, double omega,
+	double *PV, double *QV)
+{
+	double F,G,H;
+	double P,Q,R;
+	double sin_e, cos_e;
+	double sin_omega, sin_i, cos_omega, cos_i, sin_w, cos_w;
+
+	/* J2000 obliquity of the ecliptic */
+	sin_e = 0.397777156;
+	cos_e = 0.917482062;
+
+	/* equ 33.7 */
+	sin_omega = sin (ln_deg_to_rad (omega));
+	cos_omega = cos (ln_deg_to_rad (omega));
+	sin_i = sin (ln_deg_to_rad (i));
+	cos_i = cos (ln_deg_to_rad (i));
+	F = cos_omega;
+	G = sin_omega * cos_e;
+	H = sin_omega * sin_e;
+	P = -sin_omega * cos_i;
+	Q = cos_omega * cos_i * cos_e - sin_i * sin_e;
+	R = cos_omega * cos_i * sin_e + sin_i * cos_e;
+
+	/* equ 33.9 is a * sin (A + w + v); with sin A = F / a and
+	   cos A = P / a it splits into cos v and sin v parts */
+	sin_w = sin (ln_deg_to_rad (w));
+	cos_w = cos (ln_deg_to_rad (w));
+	PV[0] = F * cos_w + P * sin_w;
+	PV[1] = G * cos_w + Q * sin_w;
+	PV[2] = H * cos_w + R * sin_w;
+	QV[0] = P * cos_w - F * sin_w;
+	QV[1] = Q * cos_w - G * sin_w;
+	QV[2] = R * cos_w - H * sin_w;
+}
+
+/* transform position or velocity in orbital plane to equatorial frame */
+static void plane_to_rect (struct ln_prep_orbit *prep, double x, double y,
+	struct ln_rect_posn *posn)
+{
+	posn->X = x * prep->P[0] + y * prep->Q[0];
+	posn->Y = x * prep->P[1] + y * prep->Q[1];
+	posn->Z = x * prep->P[2] + y * prep->Q[2];
+}
+
+/*! \fn void ln_prep_ell_orbit (struct ln_ell_orbit * orbit, struct ln_prep_orbit * prep);
+* \param orbit Orbital parameters of object.
+* \param prep Pointer to store prepared orbit
+*
+* Compute all quantities of the elliptic orbit which do not depend on time,
+* so ln_get_prep_helio_rect_posn only has to solve Kepler's equation. If
+* orbit->n is zero, mean motion is calculated from the semi major axis; the
+* orbit is not modified.
+*/
+void ln_prep_ell_orbit (struct ln_ell_orbit *orbit, struct ln_prep_orbit *prep)
+{
+	prep->type = LN_ORBIT_ELLIPTIC;
+	prep->a = orbit->a;
+	prep->e = orbit->e;
+	prep->q = orbit->a * (1.0 - orbit->e);
+	prep->b = orbit->a * sqrt (1.0 - orbit->e * orbit->e);
+	prep->n = orbit->n;
+	if (prep->n == 0)
+		prep->n = ln_get_ell_mean_motion (orbit->a);
+	prep->JD = orbit->JD;
+
+	prep_orbit_plane (orbit->i, orbit->w, orbit->omega, prep->P, prep->Q);
+}
+
+/*! \fn void ln_prep_par_orbit (struct ln_par_orbit * orbit, struct ln_prep_orbit * prep);
+* \param orbit Orbital parameters of object.
+* \param prep Pointer to store prepared orbit
+*
+* Compute all quantities of the parabolic orbit which do not depend on time.
+*/
+void ln_prep_par_orbit (struct ln_par_orbit *orbit, struct ln_prep_orbit *prep)
+{
+	prep->type = LN_ORBIT_PARABOLIC;
+	prep->q = orbit->q;
+	prep->e = 1.0;
+	prep->a = prep->b = prep->n = 0;
+	prep->JD = orbit->JD;
+
+	prep_orbit_plane (orbit->i, orbit->w, orbit->omega, prep->P, prep->Q);
+}
+
+/*! \fn void ln_prep_hyp_orbit (struct ln_hyp_orbit * orbit, struct ln_prep_orbit * prep);
+* \param orbit Orbital parameters of object.
+* \param prep Pointer to store prepared orbit
+*
+* Compute all quantities of the hyperbolic orbit which do not depend on time.
+*/
+void ln_prep_hyp_orbit (struct ln_hyp_orbit *orbit, struct ln_prep_orbit *prep)
+{
+	prep->type = LN_ORBIT_HYPERBOLIC;
+	prep->q = orbit->q;
+	prep->e = orbit->e;
+	prep->a = prep->b = prep->n = 0;
+	prep->JD = orbit->JD;
+
+	prep_orbit_plane (orbit->i, orbit->w, orbit->omega, prep->P, prep->Q);
+}
+
+/*! \fn void ln_get_prep_helio_rect_posn (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn);
+* \param prep Prepared orbit.
+* \param JD Julian day
+* \param posn Position pointer to store objects position
+*
+* Calculate the objects rectangular heliocentric position on prepared orbit
+* for the given julian day. Result is the same as of ln_get_ell_helio_rect_posn,
+* ln_get_par_helio_rect_posn or ln_get_hyp_helio_rect_posn, but only the
+* equation of the anomaly is solved for each call.
+*/
+void ln_get_prep_helio_rect_posn (struct ln_prep_orbit *prep, double JD,
+	struct ln_rect_posn *posn)
+{
+	double t, E, s, x, y, vx, vy;
+
+	/* time since perihelion */
+	t = JD - prep->JD;
+
+	switch (prep->type) {
+		case LN_ORBIT_ELLIPTIC:
+			E = ln_deg_to_rad (ln_solve_kepler (prep->e,
+				ln_get_ell_mean_anomaly (prep->n, t)));
+			x = prep->a * (cos (E) - prep->e);
+			y = prep->b * sin (E);
+			break;
+		case LN_ORBIT_PARABOLIC:
+			/* s = tan (v / 2) */
+			s = ln_solve_barker (prep->q, t);
+			x = prep->q * (1.0 - s * s);
+			y = 2.0 * prep->q * s;
+			break;
+		default:
+			get_universal_plane_state (prep->q, prep->e, GAUS_GRAV, t, &x, &y,
+				&vx, &vy);
+			break;
+	}
+
+	plane_to_rect (prep, x, y, posn);
+}
+
+/*! \fn double ln_solve_universal (double q, double e, double t);
+* \param q Perihelion distance in AU
+* \param e Orbit eccentricity
+* \param t Time since perihelion in days
+* \return Universal anomaly
+*
+* Solve Kepler's equation in universal variable for heliocentric orbit of
+* any eccentricity. For elliptic orbit result is sqrt (a) * E, for parabolic
+* orbit sqrt (2 q) * tan (v / 2) and for hyperbolic orbit sqrt (-a) * H.
+* Elliptic orbits are reduced to the revolution nearest to perihelion.
+*/
+double ln_solve_universal (double q, double e, double t)
+{
+	double c2, c3;
+
+	return solve_universal (q, e, GAUS_GRAV, t, &c2, &c3);
+}
+
+/*! \fn void ln_prep_univ_orbit (struct ln_hyp_orbit * orbit, struct ln_prep_orbit * prep);
+* \param orbit Orbital parameters of object, eccentricity can be of any value.
+* \param prep Pointer to store prepared orbit
+*
+* Prepare orbit given by perihelion distance and eccentricity, as listed in
+* comet catalogues. Type of prepared orbit is selected by eccentricity.
+*/
+void ln_prep_univ_orbit (struct ln_hyp_orbit *orbit, struct ln_prep_orbit *prep)
+{
+	struct ln_ell_orbit ell;
+
+	if (orbit->e < 1.0) {
+		ell.a = orbit->q / (1.0 - orbit->e);
+		ell.e = orbit->e;
+		ell.i = orbit->i;
+		ell.w = orbit->w;
+		ell.omega = orbit->omega;
+		ell.n = 0;
+		ell.JD = orbit->JD;
+		ln_prep_ell_orbit (&ell, prep);
+		return;
+	}
+
+	ln_prep_hyp_orbit (orbit, prep);
+	if (orbit->e == 1.0)
+		prep->type = LN_ORBIT_PARABOLIC;
+}
+
+/*! \fn void ln_get_prep_univ_helio_rect_posn (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn);
+* \param prep Prepared orbit.
+* \param JD Julian day
+* \param posn Position pointer to store objects position
+*
+* Calculate the objects rectangular heliocentric position on prepared orbit
+* of any type with one solver of the universal Kepler's equation. Mean motion
+* of elliptic orbit is respected.
+*/
+void ln_get_prep_univ_helio_rect_posn (struct ln_prep_orbit *prep, double JD,
+	struct ln_rect_posn *posn)
+{
+	double k, x, y, vx, vy;
+
+	/* sqrt (GM), from mean motion for elliptic orbits */
+	if (prep->type == LN_ORBIT_ELLIPTIC)
+		k = ln_deg_to_rad (prep->n) * prep->a * sqrt (prep->a);
+	else
+		k = GAUS_GRAV;
+
+	get_universal_plane_state (prep->q, prep->e, k, JD - prep->JD, &x, &y,
+		&vx, &vy);
+
+	plane_to_rect (prep, x, y, posn);
+}
+
+/*! \fn void ln_get_prep_helio_rect_state (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+* \param prep Prepared orbit.
+* \param JD Julian day
+* \param posn Position pointer to store objects position
+* \param vel Pointer to store objects velocity in AU per day
+*
+* Calculate the objects rectangular heliocentric position and velocity on
+* prepared orbit for the given julian day. Position is the same as of
+* ln_get_prep_helio_rect_posn, velocity is its analytical derivative.
+*/
+void ln_get_prep_helio_rect_state (struct ln_prep_orbit *prep, double JD,
+	struct ln_rect_posn *posn, struct ln_rect_posn *vel)
+{
+	double t, E, dE, s, ds, x, y, vx, vy;
+
+	/* time since perihelion */
+	t = JD - prep->JD;
+
+	switch (prep->type) {
+		case LN_ORBIT_ELLIPTIC:
+			E = ln_deg_to_rad (ln_solve_kepler (prep->e,
+				ln_get_ell_mean_anomaly (prep->n, t)));
+			x = prep->a * (cos (E) - prep->e);
+			y = prep->b * sin (E);
+			/* derivative of equ 30.5 */
+			dE = ln_deg_to_rad (prep->n) / (1.0 - prep->e * cos (E));
+			vx = -prep->a * sin (E) * dE;
+			vy = prep->b * cos (E) * dE;
+			break;
+		case LN_ORBIT_PARABOLIC:
+			s = ln_solve_barker (prep->q, t);
+			x = prep->q * (1.0 - s * s);
+			y = 2.0 * prep->q * s;
+			/* derivative of Barker's equation, 3 s + s^3 = W */
+			ds = GAUS_GRAV / (M_SQRT2 * prep->q * sqrt (prep->q) * (1.0 + s * s));
+			vx = -2.0 * prep->q * s * ds;
+			vy = 2.0 * prep->q * ds;
+			break;
+		default:
+			get_universal_plane_state (prep->q, prep->e, GAUS_GRAV, t, &x, &y,
+				&vx, &vy);
+			break;
+	}
+
+	plane_to_rect (prep, x, y, posn);
+	plane_to_rect (prep, vx, vy, vel);
+}
+
+/*! \fn void ln_get_prep_univ_helio_rect_state (struct ln_prep_orbit * prep, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+* \param prep Prepared orbit.
+* \param JD Julian day
+* \param posn Position pointer to store objects position
+* \param vel Pointer to store objects velocity in AU per day
+*
+* Calculate the objects rectangular heliocentric position and velocity on
+* prepared orbit of any type with universal variable, see
+* ln_get_prep_univ_helio_rect_posn.
+*/
+void ln_get_prep_univ_helio_rect_state (struct ln_prep_orbit *prep, double JD,
+	struct ln_rect_posn *posn, struct ln_rect_posn *vel)
+{
+	double k, x, y, vx, vy;
+
+	if (prep->type == LN_ORBIT_ELLIPTIC)
+		k = ln_deg_to_rad (prep->n) * prep->a * sqrt (prep->a);
+	else
+		k = GAUS_GRAV;
+
+	get_universal_plane_state (prep->q, prep->e, k, JD - prep->JD, &x, &y,
+		&vx, &vy);
+
+	plane_to_rect (prep, x, y, posn);
+	plane_to_rect (prep, vx, vy, vel);
+}
+
+/*! \fn void ln_get_prep_univ_equ_coords (double JD, struct ln_prep_orbit * prep, int count, struct ln_equ_posn * posn, double * dist);
+* \param JD Julian day
+* \param prep Array of count prepared orbits of any type
+* \param count Number of orbits
+* \param posn Array of count positions to store equatorial coordinates
+* \param dist Array of count elements to store distances from the Earth in AU, or NULL
+*
+* Calculate geocentric equatorial coordinates, corrected for light time,
+* of all bodies in mixed catalogue of orbits. The Earth's position is
+* calculated only once.
+*/
+void ln_get_prep_univ_equ_coords (double JD, struct ln_prep_orbit *prep,
+	int count, struct ln_equ_posn *posn, double *dist)
+{
+	struct ln_helio_posn h_earth;
+	struct ln_rect_posn earth, body;
+	double d;
+	int i;
+
+	ln_get_earth_helio_coords (JD, &h_earth);
+	ln_get_rect_from_helio (&h_earth, &earth);
+
+	for (i = 0; i < count; i++) {
+		ln_get_prep_univ_helio_rect_posn (prep + i, JD, &body);
+		d = ln_get_rect_distance (&body, &earth);
+		ln_get_prep_univ_helio_rect_posn (prep + i, JD - ln_get_light_time (d),
+			&body);
+		body.X -= earth.X;
+		body.Y -= earth.Y;
+		body.Z -= earth.Z;
+		d = sqrt (body.X * body.X + body.Y * body.Y + body.Z * body.Z);
+
+		posn[i].ra = ln_range_degrees (ln_rad_to_deg (atan2 (body.Y, body.X)));
+		posn[i].dec = ln_rad_to_deg (asin (body.Z / d));
+		if (dist)
+			dist[i] = d;
+	}
+}
+
+/*! \fn void ln_prep_ell_orbits (struct ln_ell_orbits * orbits, double * buffer, struct ln_prep_ell_orbits * prep);
+* \param orbits Arrays of orbital parameters.
+* \param buffer Buffer of LN_PREP_ELL_ORBIT_DOUBLES * orbits->count doubles
+* \param prep Pointer to store prepared orbits, its arrays will point into buffer
+*
+* Prepare many elliptic orbits for ln_get_prep_ell_orbits_equ_coords, as
+* ln_prep_ell_orbit does for a single orbit. Buffer must stay valid as long
+* as prep is used.
+*/
+void ln_prep_ell_orbits (struct ln_ell_orbits *orbits, double *buffer,
+	struct ln_prep_ell_orbits *prep)
+{
+	double P[3], Q[3];
+	int i, j, count = orbits->count;
+
+	prep->count = count;
+	prep->a = buffer;
+	prep->b = buffer + count;
+	prep->e = buffer + 2 * count;
+	prep->n = buffer + 3 * count;
+	prep->JD = buffer + 4 * count;
+	for (j = 0; j < 3; j++) {
+		prep->P[j] = buffer + (5 + j) * count;
+		prep->Q[j] = buffer + (8 + j) * count;
+	}
+
+	for (i = 0; i < count; i++) {
+		prep->a[i] = orbits->a[i];
+		prep->e[i] = orbits->e[i];
+		prep->b[i] = orbits->a[i] * sqrt (1.0 - orbits->e[i] * orbits->e[i]);
+		prep->n[i] = orbits->n[i];
+		if (prep->n[i] == 0)
+			prep->n[i] = ln_get_ell_mean_motion (orbits->a[i]);
+		prep->JD[i] = orbits->JD[i];
+
+		prep_orbit_plane (orbits->i[i], orbits->w[i], orbits->omega[i], P, Q);
+		for (j = 0; j < 3; j++) {
+			prep->P[j][i] = P[j];
+			prep->Q[j][i] = Q[j];
+		}
+	}
+}
+
+/*! \fn void ln_get_prep_ell_orbits_equ_coords_chunk (double JD, struct ln_prep_ell_orbits * prep, struct ln_rect_posn * earth, int start, int count, double * ra, double * dec, double * dist);
+* \param JD Julian day
+* \param prep Prepared orbits
+* \param earth Heliocentric rectangular equatorial position of the Earth at JD
+* \param start Index of the first orbit
+* \param count Number of orbits
+* \param ra Array to store right ascensions in degrees
+* \param dec Array to store declinations in degrees
+* \param dist Array to store distances from the Earth in AU
+*
+* Calculate geocentric equatorial coordinates, corrected for light time,
+* of bodies start to start + count - 1. Results are stored at the same
+* indices as the orbits. The function uses no static data, so different
+* chunks can be computed by different threads sharing one Earth position.
+*/
+void ln_get_prep_ell_orbits_equ_coords_chunk (double JD,
+	struct ln_prep_ell_orbits *prep, struct ln_rect_posn *earth, int start,
+	int count, double *ra, double *dec, double *dist)
+{
+	double M[ORBITS_BLOCK], E[ORBITS_BLOCK], t[ORBITS_BLOCK];
+	double x, y, X, Y, Z, d;
+	int i, j, k, m, pass;
+
+	for (i = start; i < start + count; i += ORBITS_BLOCK) {
+		m = start + count - i;
+		if (m > ORBITS_BLOCK)
+			m = ORBITS_BLOCK;
+
+		/* second pass repeats the calculation at JD - light time */
+		for (j = 0; j < m; j++)
+			t[j] = 0;
+
+		for (pass = 0; pass < 2; pass++) {
+			for (j = 0; j < m; j++) {
+				k = i + j;
+				M[j] = ln_get_ell_mean_anomaly (prep->n[k], JD - t[j] - prep->JD[k]);
+			}
+			ln_solve_kepler_batch (prep->e + i, M, E, m);
+
+			for (j = 0; j < m; j++) {
+				k = i + j;
+				E[j] = ln_deg_to_rad (E[j]);
+				x = prep->a[k] * (cos (E[j]) - prep->e[k]);
+				y = prep->b[k] * sin (E[j]);
+				X = x * prep->P[0][k] + y * prep->Q[0][k] - earth->X;
+				Y = x * prep->P[1][k] + y * prep->Q[1][k] - earth->Y;
+				Z = x * prep->P[2][k] + y * prep->Q[2][k] - earth->Z;
+				d = sqrt (X * X + Y * Y + Z * Z);
+
+				if (pass == 0) {
+					t[j] = ln_get_light_time (d);
+					continue;
+				}
+				ra[k] = ln_range_degrees (ln_rad_to_deg (atan2 (Y, X)));
+				dec[k] = ln_rad_to_deg (asin (Z / d));
+				dist[k] = d;
+			}
+		}
+	}
+}
+
+/*! \fn void ln_get_prep_ell_orbits_equ_coords (double JD, struct ln_prep_ell_orbits * prep, double * ra, double * dec, double * dist);
+* \param JD Julian day
+* \param prep Prepared orbits
+* \param ra Array of prep->count elements to store right ascensions in degrees
+* \param dec Array of prep->count elements to store declinations in degrees
+* \param dist Array of prep->count elements to store distances from the Earth in AU
+*
+* Calculate geocentric equatorial coordinates of all bodies on prepared
+* orbits, corrected for light time. The Earth's position is calculated only
+* once, Kepler's equation is solved in blocks by ln_solve_kepler_batch and,
+* when the library is built with OpenMP, chunks of orbits are distributed
+* among threads. Other threading libraries can call
+* ln_get_prep_ell_orbits_equ_coords_chunk directly.
+*/
+void ln_get_prep_ell_orbits_equ_coords (double JD,
+	struct ln_prep_ell_orbits *prep, double *ra, double *dec, double *dist)
+{
+	struct ln_helio_posn h_earth;
+	struct ln_rect_posn earth;
+	int i, count;
+
+	ln_get_earth_helio_coords (JD, &h_earth);
+	ln_get_rect_from_helio (&h_earth, &earth);
+
+#ifdef _OPENMP
+#pragma omp parallel for private(count) schedule(dynamic)
+#endif
+	for (i = 0; i < prep->count; i += ORBITS_CHUNK) {
+		count = prep->count - i;
+		if (count > ORBITS_CHUNK)
+			count = ORBITS_CHUNK;
+		ln_get_prep_ell_orbits_equ_coords_chunk (JD, prep, &earth, i, count,
+			ra, dec, dist);
+	}
+}
+
+/*! \fn void ln_get_prep_orbits_mag (double JD, struct ln_prep_orbit * prep, struct ln_mag_params * params, int count, double * mag, double * phase, double * elong, double * diam);
+* \param JD Julian day
+* \param prep Array of count prepared orbits of any type
+* \param params Array of count photometric parameters
+* \param count Number of orbits
+* \param mag Array to store visual magnitudes, or NULL
+* \param phase Array to store phase angles in degrees, or NULL
+* \param elong Array to store elongations to the Sun in degrees, or NULL
+* \param diam Array to store apparent diameters in arc seconds, or NULL
+*
+* Calculate photometric quantities of all bodies in catalogue of asteroids
+* and comets. The Earth's position is calculated once and the position of
+* each body, corrected for light time, only once for all the quantities.
+* Magnitudes use the H, G system for asteroids and the g, k system for
+* comets. The apparent diameter of asteroids is derived from H and albedo
+* as in ln_get_asteroid_sdiam_km, it is 0 for comets and asteroids with
+* unknown albedo.
+*/
+void ln_get_prep_orbits_mag (double JD, struct ln_prep_orbit *prep,
+	struct ln_mag_params *params, int count, double *mag, double *phase,
+	double *elong, double *diam)
+{
+	struct ln_rect_posn earth, posn, vel, geo;
+	double R, r, d, b, t, t1, t2;
+	int i;
+
+	ln_get_earth_rect_helio (JD, &earth);
+	R = sqrt (earth.X * earth.X + earth.Y * earth.Y + earth.Z * earth.Z);
+
+#ifdef _OPENMP
+#pragma omp parallel for private(posn, vel, geo, r, d, b, t, t1, t2)
+#endif
+	for (i = 0; i < count; i++) {
+		ln_get_prep_univ_helio_rect_state (prep + i, JD, &posn, &vel);
+		ln_get_light_time_geo_posn (&earth, &posn, &vel, &geo);
+
+		/* heliocentric position at JD - light time */
+		posn.X = geo.X + earth.X;
+		posn.Y = geo.Y + earth.Y;
+		posn.Z = geo.Z + earth.Z;
+		r = sqrt (posn.X * posn.X + posn.Y * posn.Y + posn.Z * posn.Z);
+		d = sqrt (geo.X * geo.X + geo.Y * geo.Y + geo.Z * geo.Z);
+
+		/* angle Sun - body - Earth */
+		b = (posn.X * geo.X + posn.Y * geo.Y + posn.Z * geo.Z) / (r * d);
+		b = acos (b > 1.0 ? 1.0 : (b < -1.0 ? -1.0 : b));
+
+		if (phase)
+			phase[i] = ln_rad_to_deg (b);
+		if (elong) {
+			t = -(earth.X * geo.X + earth.Y * geo.Y + earth.Z * geo.Z) / (R * d);
+			elong[i] = ln_rad_to_deg (acos (t > 1.0 ? 1.0 : (t < -1.0 ? -1.0 : t)));
+		}
+
+		if (params[i].type == LN_MAG_COMET) {
+			if (mag)
+				mag[i] = params[i].H + 5.0 * log10 (d) + params[i].G * log10 (r);
+			if (diam)
+				diam[i] = 0;
+			continue;
+		}
+
+		if (mag) {
+			t = tan (b / 2.0);
+			t1 = exp (-3.33 * pow (t, 0.63));
+			t2 = exp (-1.87 * pow (t, 1.22));
+			mag[i] = params[i].H + 5.0 * log10 (r * d) -
+				2.5 * log10 ((1.0 - params[i].G) * t1 + params[i].G * t2);
+		}
+		if (diam) {
+			if (params[i].A > 0)
+				diam[i] = 0.0013788 * pow (10.0,
+					ln_get_asteroid_sdiam_km (params[i].H, params[i].A)) / d;
+			else
+				diam[i] = 0;
+		}
+	}
+}
@@ -18,9 +18,11 @@
 
 #include <math.h>
 #include <libnova/parabolic_motion.h>
+#include <libnova/orbit.h>
 #include <libnova/solar.h>
 #include <libnova/earth.h>
 #include <libnova/transform.h>
+#include <libnova/light_time.h>
 #include <libnova/rise_set.h>
 #include <libnova/dynamical_time.h>
 #include <libnova/sidereal_time.h>
@@ -90,55 +92,32 @@ double ln_get_par_radius_vector (double q, double t)
 * \param posn Position pointer to store objects position
 *
 * Calculate the objects rectangular heliocentric position given it's orbital
-* elements for the given julian day. 
+* elements for the given julian day. When computing many positions on the
+* same orbit, use ln_prep_par_orbit and ln_get_prep_helio_rect_posn.
 */
 void ln_get_par_helio_rect_posn (struct ln_par_orbit* orbit, double JD, struct ln_rect_posn* posn)
 {
-	double A,B,C;
-	double F,G,H;
-	double P,Q,R;
-	double sin_e, cos_e;
-	double a,b,c;
-	double sin_omega, sin_i, cos_omega, cos_i;
-	double r,v,t;
-	
-	/* time since perihelion */
-	t = JD - orbit->JD;
-	
-	/* J2000 obliquity of the ecliptic */
-	sin_e = 0.397777156;
-	cos_e = 0.917482062;
-	
-	/* equ 33.7 */
-	sin_omega = sin (ln_deg_to_rad (orbit->omega));
-	cos_omega = cos (ln_deg_to_rad (orbit->omega));
-	sin_i = sin (ln_deg_to_rad  (orbit->i));
-	cos_i = cos (ln_deg_to_rad  (orbit->i));
-	F = cos_omega;
-	G = sin_omega * cos_e;
-	H = sin_omega * sin_e;
-	P = -sin_omega * cos_i;
-	Q = cos_omega * cos_i * cos_e - sin_i * sin_e;
-	R = cos_omega * cos_i * sin_e + sin_i * cos_e;
-	
-	/* equ 33.8 */
-	A = atan2 (F,P);
-	B = atan2 (G,Q);
-	C = atan2 (H,R);
-	a = sqrt (F * F + P * P);
-	b = sqrt (G * G + Q * Q);
-	c = sqrt (H * H + R * R);
-	
-	/* get true anomaly */
-	v = ln_get_par_true_anomaly (orbit->q, t);
-	
-	/* get radius vector */
-	r = ln_get_par_radius_vector (orbit->q, t);
+	struct ln_prep_orbit prep;
+
+	ln_prep_par_orbit (orbit, &prep);
+	ln_get_prep_helio_rect_posn (&prep, JD, posn);
+}
 
-	/* equ 33.9 */
-	posn->X = r * a * sin (A + ln_deg_to_rad(orbit->w + v));
-	posn->Y = r * b * sin (B + ln_deg_to_rad(orbit->w + v));
-	posn->Z = r * c * sin (C + ln_deg_to_rad(orbit->w + v));
+/*! \fn void ln_get_par_helio_rect_state (struct ln_par_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel);
+* \param orbit Orbital parameters of object.
+* \param JD Julian day
+* \param posn Position pointer to store objects position
+* \param vel Pointer to store objects velocity in AU per day
+*
+* Calculate the objects rectangular heliocentric position and velocity given
+* it's orbital elements for the given julian day.
+*/
+void ln_get_par_helio_rect_state (struct ln_par_orbit* orbit, double JD, struct ln_rect_posn* posn, struct ln_rect_posn* vel)
+{
+	struct ln_prep_orbit prep;
+
+	ln_prep_par_orbit (orbit, &prep);
+	ln_get_prep_helio_rect_state (&prep, JD, posn, vel);
 }
 
 
@@ -178,28 +157,16 @@ void ln_get_par_geo_rect_posn (struct ln_par_orbit* orbit, double JD, struct ln_
 */
 void ln_get_par_body_equ_coords (double JD, struct ln_par_orbit * orbit, struct ln_equ_posn * posn)
 {
-	struct ln_rect_posn body_rect_posn, sol_rect_posn;
-	double dist, t;
-	double x,y,z;
-	
-	/* get solar and body rect coords */
-	ln_get_par_helio_rect_posn (orbit, JD, &body_rect_posn);
-	ln_get_solar_geo_coords (JD, &sol_rect_posn);
+	struct ln_rect_posn body_rect_posn, body_vel, earth_rect_posn, geo_rect_posn;
 
-	/* calc distance and light time */
-	dist = ln_get_rect_distance (&body_rect_posn, &sol_rect_posn);
-	t = ln_get_light_time (dist);
-	
-	/* repeat calculation with new time (i.e. JD - t) */
-	ln_get_par_helio_rect_posn (orbit, JD - t, &body_rect_posn);
-	
-	/* calc equ coords equ 33.10 */
-	x = sol_rect_posn.X + body_rect_posn.X;
-	y = sol_rect_posn.Y + body_rect_posn.Y;
-	z = sol_rect_posn.Z + body_rect_posn.Z;
+	/* get earth and body rect coords */
+	ln_get_par_helio_rect_state (orbit, JD, &body_rect_posn, &body_vel);
+	ln_get_earth_rect_helio (JD, &earth_rect_posn);
 
-	posn->ra = ln_range_degrees (ln_rad_to_deg(atan2 (y,x)));
-	posn->dec = ln_rad_to_deg(atan2 (z,sqrt (x * x + y * y)));
+	/* correct for light time and calc equ coords equ 33.10 */
+	ln_get_light_time_geo_posn (&earth_rect_posn, &body_rect_posn, &body_vel,
+		&geo_rect_posn);
+	ln_get_equ_from_rect (&geo_rect_posn, posn);
 }
 
 
@@ -39,6 +39,31 @@ void get_topocentric (struct ln_lnlat_posn * observer, double height, double * r
 	*ro_cos = fabs (*ro_cos);
 }
 
+/* parallax from geocentric constants of observer and hour angle in hours */
+static void get_parallax (double ro_sin, double ro_cos,
+	struct ln_equ_posn * object, double au_distance, double H,
+	struct ln_equ_posn * parallax)
+{
+	double sin_pi, sin_H, cos_H, dec_rad, cos_dec;
+
+	sin_pi = sin (ln_deg_to_rad (8.794 / 3600.0)) / au_distance;  // (39.1)
+
+	/* change hour angle from hours to radians*/
+	H *= M_PI / 12.0;
+
+	sin_H = sin (H);
+	cos_H = cos (H);
+
+	dec_rad = ln_deg_to_rad (object->dec);
+	cos_dec = cos (dec_rad);
+	
+	parallax->ra = atan2 (-ro_cos * sin_pi * sin_H, cos_dec  - ro_cos * sin_pi * cos_H); // (39.2)
+	parallax->dec = atan2 ((sin (dec_rad) - ro_sin * sin_pi) * cos (parallax->ra), cos_dec - ro_cos * sin_pi * cos_H); // (39.3)
+
+	parallax->ra = ln_rad_to_deg (parallax->ra);
+	parallax->dec = ln_rad_to_deg (parallax->dec) - object->dec;
+}
+
 /*! \fn void ln_get_parallax (struct ln_equ_posn * object, double au_distance, struct ln_lnlat_posn * observer, double height, double JD, struct ln_equ_posn * parallax);
 * \param object Object geocentric coordinates
 * \param au_distance Distance of object from Earth in AU
@@ -86,22 +111,102 @@ void ln_get_parallax_ha
 	 double H,
 	 struct ln_equ_posn * parallax)
 {
-	double sin_pi, ro_sin, ro_cos, sin_H, cos_H, dec_rad, cos_dec;
+	double ro_sin, ro_cos;
+
 	get_topocentric (observer, height, &ro_sin, &ro_cos);
-	sin_pi = sin (ln_deg_to_rad ((8.794 / au_distance) / 3600.0));  // (39.1)
+	get_parallax (ro_sin, ro_cos, object, au_distance, H, parallax);
+}
 
-	/* change hour angle from hours to radians*/
-	H *= M_PI / 12.0;
+/*! \fn void ln_prep_topo_observer (struct ln_lnlat_posn * observer, double height, struct ln_topo_observer * topo)
+* \param observer Geographics observer positions
+* \param height Observer height in m
+* \param topo Pointer to store prepared observer
+*
+* Prepare observer for topocentric reductions. Geocentric constants
+* ro_sin and ro_cos of the observer are calculated once. Set the time with
+* ln_set_topo_observers_time before use.
+*/
+void ln_prep_topo_observer (struct ln_lnlat_posn * observer, double height, struct ln_topo_observer * topo)
+{
+	topo->lng = observer->lng;
+	topo->lat = observer->lat;
+	get_topocentric (observer, height, &topo->ro_sin, &topo->ro_cos);
+	topo->JD = 0;
+	topo->sidereal = 0;
+}
 
-	sin_H = sin (H);
-	cos_H = cos (H);
+/*! \fn void ln_set_topo_observers_time (struct ln_topo_observer * topo, int count, double JD)
+* \param topo Array of count prepared observers
+* \param count Number of observers
+* \param JD Julian day of observation
+*
+* Set the time of observation of prepared observers. Apparent sidereal
+* time, and thus nutation, is calculated once for all observers.
+*/
+void ln_set_topo_observers_time (struct ln_topo_observer * topo, int count, double JD)
+{
+	double sidereal;
+	int i;
 
-	dec_rad = ln_deg_to_rad (object->dec);
-	cos_dec = cos (dec_rad);
-	
-	parallax->ra = atan2 (-ro_cos * sin_pi * sin_H, cos_dec  - ro_cos * sin_pi * cos_H); // (39.2)
-	parallax->dec = atan2 ((sin (dec_rad) - ro_sin * sin_pi) * cos (parallax->ra), cos_dec - ro_cos * sin_pi * cos_H); // (39.3)
+	sidereal = ln_get_apparent_sidereal_time (JD);
+	for (i = 0; i < count; i++) {
+		topo[i].JD = JD;
+		topo[i].sidereal = sidereal + topo[i].lng / 15.0;
+	}
+}
 
-	parallax->ra = ln_rad_to_deg (parallax->ra);
-	parallax->dec = ln_rad_to_deg (parallax->dec) - object->dec;
+/*! \fn void ln_get_topo_parallax (struct ln_topo_observer * topo, struct ln_equ_posn * object, double au_distance, struct ln_equ_posn * parallax)
+* \param topo Prepared observer with time set
+* \param object Object geocentric coordinates
+* \param au_distance Distance of object from Earth in AU
+* \param parallax RA and DEC parallax
+*
+* Calculate body parallax for a prepared observer, same as
+* ln_get_parallax.
+*/
+void ln_get_topo_parallax (struct ln_topo_observer * topo, struct ln_equ_posn * object, double au_distance, struct ln_equ_posn * parallax)
+{
+	get_parallax (topo->ro_sin, topo->ro_cos, object, au_distance,
+		topo->sidereal - object->ra / 15.0, parallax);
+}
+
+/*! \fn void ln_get_topo_equ_coords_batch (struct ln_topo_observer * topo, double * ra, double * dec, double * dist, int count, double * topo_ra, double * topo_dec, double * topo_dist)
+* \param topo Prepared observer with time set
+* \param ra Array of count geocentric right ascensions in degrees
+* \param dec Array of count geocentric declinations in degrees
+* \param dist Array of count distances from Earth in AU
+* \param count Number of objects
+* \param topo_ra Array to store topocentric right ascensions
+* \param topo_dec Array to store topocentric declinations
+* \param topo_dist Array to store topocentric distances in AU, or NULL
+*
+* Calculate topocentric coordinates of many objects for one observer, e.g.
+* of a catalogue of near-Earth objects. The geocentric position of each
+* object is shifted by the observer's position in the frame of hour angle,
+* which gives the same coordinates as ln_get_parallax. Input and output
+* arrays may be the same.
+*/
+/* vector form of equ 39.2, 39.3 */
+void ln_get_topo_equ_coords_batch (struct ln_topo_observer * topo, double * ra, double * dec, double * dist, int count, double * topo_ra, double * topo_dec, double * topo_dist)
+{
+	double sidereal, sin_pi, cos_dec, H, x, y, z;
+	int i;
+
+	sidereal = topo->sidereal * 15.0;
+
+	for (i = 0; i < count; i++) {
+		sin_pi = sin (ln_deg_to_rad (8.794 / 3600.0)) / dist[i];
+
+		/* geocentric vector minus observer vector, in units of distance */
+		H = ln_deg_to_rad (sidereal - ra[i]);
+		cos_dec = cos (ln_deg_to_rad (dec[i]));
+		x = cos_dec * cos (H) - topo->ro_cos * sin_pi;
+		y = cos_dec * sin (H);
+		z = sin (ln_deg_to_rad (dec[i])) - topo->ro_sin * sin_pi;
+
+		if (topo_dist)
+			topo_dist[i] = dist[i] * sqrt (x * x + y * y + z * z);
+		topo_ra[i] = ln_range_degrees (sidereal - ln_rad_to_deg (atan2 (y, x)));
+		topo_dec[i] = ln_rad_to_deg (atan2 (z, sqrt (x * x + y * y)));
+	}
 }
@@ -23,6 +23,7 @@
 #include <libnova/solar.h>
 #include <libnova/earth.h>
 #include <libnova/transform.h>
+#include <libnova/light_time.h>
 #include <libnova/rise_set.h>
 #include <libnova/utility.h>
 
@@ -245,38 +246,11 @@ static const struct pluto_radius radius[PLUTO_COEFFS] = {
 */ 
 void ln_get_pluto_equ_coords (double JD, struct ln_equ_posn * position)
 {
-	struct ln_helio_posn h_sol, h_pluto;
-	struct ln_rect_posn g_sol, g_pluto;
-	double a,b,c;
-	double ra, dec, delta, diff, last, t = 0;
-	
-	/* need typdef for solar heliocentric coords */
-	ln_get_solar_geom_coords (JD, &h_sol);
-	ln_get_rect_from_helio (&h_sol,  &g_sol);
-	
-	do {
-		last = t;
-		ln_get_pluto_helio_coords (JD - t, &h_pluto);
-		ln_get_rect_from_helio (&h_pluto, &g_pluto);
-
-		/* equ 33.10 pg 229 */
-		a = g_sol.X + g_pluto.X;
-		b = g_sol.Y + g_pluto.Y;
-		c = g_sol.Z + g_pluto.Z;
-	
-		delta = a*a + b*b + c*c;
-		delta = sqrt (delta);
-		t = delta * 0.0057755183;
-		diff = t - last;
-	} while (diff > 0.0001 || diff < -0.0001);
-		
-	ra = atan2 (b,a);
-	dec = c / delta;
-	dec = asin (dec);
+	struct ln_rect_posn g_pluto;
 
-	/* back to hours, degrees */
-	position->ra = ln_range_degrees(ln_rad_to_deg (ra));
-	position->dec = ln_rad_to_deg (dec);
+	/* light time corrected geocentric position, equ 33.10 pg 229 */
+	ln_get_body_light_time_geo_posn (JD, ln_get_pluto_rect_helio_state, &g_pluto);
+	ln_get_equ_from_rect (&g_pluto, position);
 }
 	
 	
@@ -393,6 +367,32 @@ double ln_get_pluto_solar_dist (double JD)
 	return h_pluto.R;
 }
 	
+/*! \fn void ln_get_pluto_geom (double JD, struct ln_planet_geom * geom);
+* \param JD Julian day
+* \param geom Pointer to store geometry
+*
+* Calculate distances of Pluto from the Sun and the Earth and its phase
+* angle, corrected for light time. Magnitude, illuminated fraction and
+* semidiameter of Pluto are derived from the geometry.
+*/
+void ln_get_pluto_geom (double JD, struct ln_planet_geom * geom)
+{
+	ln_get_body_geom (JD, ln_get_pluto_rect_helio_state, geom);
+}
+
+/*! \fn double ln_get_pluto_geom_magnitude (struct ln_planet_geom * geom);
+* \param geom Geometry of Pluto from ln_get_pluto_geom
+* \return Visible magnitude of Pluto
+*
+* Calculate the visible magnitude of Pluto from its geometry.
+*/
+double ln_get_pluto_geom_magnitude (struct ln_planet_geom * geom)
+{
+	double r = geom->r, delta = geom->delta;
+
+	return -1.0 + 5 * log10 (r * delta);
+}
+
 /*! \fn double ln_get_pluto_magnitude (double JD);
 * \param JD Julian day
 * \return Visible magnitude of Pluto
@@ -402,13 +402,10 @@ double ln_get_pluto_solar_dist (double JD)
 */ 
 double ln_get_pluto_magnitude (double JD)
 {
-	double delta, r;
-	
-	/* get distances */
-	r = ln_get_pluto_solar_dist (JD);
-	delta = ln_get_pluto_earth_dist (JD);
+	struct ln_planet_geom geom;
 
-	return -1.0 + 5 * log10 (r * delta);
+	ln_get_pluto_geom (JD, &geom);
+	return ln_get_pluto_geom_magnitude (&geom);
 }
 
 /*! \fn double ln_get_pluto_disk (double JD);
@@ -421,15 +418,10 @@ double ln_get_pluto_magnitude (double JD)
 /* Chapter 41 */
 double ln_get_pluto_disk (double JD)
 {
-	double r,delta,R;	
-	
-	/* get distances */
-	R = ln_get_earth_solar_dist (JD);
-	r = ln_get_pluto_solar_dist (JD);
-	delta = ln_get_pluto_earth_dist (JD);
-	
-	/* calc fraction angle */
-	return (((r + delta) * (r + delta)) - R * R) / (4 * r * delta);
+	struct ln_planet_geom geom;
+
+	ln_get_pluto_geom (JD, &geom);
+	return ln_get_planet_geom_disk (&geom);
 }
 
 /*! \fn double ln_get_pluto_phase (double JD);
@@ -442,17 +434,10 @@ double ln_get_pluto_disk (double JD)
 /* Chapter 41 */
 double ln_get_pluto_phase (double JD)
 {
-	double i,r,delta,R;	
-	
-	/* get distances */
-	R = ln_get_earth_solar_dist (JD);
-	r = ln_get_pluto_solar_dist (JD);
-	delta = ln_get_pluto_earth_dist (JD);
-
-	/* calc phase */
-	i = (r * r + delta * delta - R * R) / (2 * r * delta);
-	i = acos (i);
-	return ln_rad_to_deg (i);
+	struct ln_planet_geom geom;
+
+	ln_get_pluto_geom (JD, &geom);
+	return geom.phase;
 }
 
 
@@ -482,12 +467,24 @@ int ln_get_pluto_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_
 * given julian day.
 */
 double ln_get_pluto_sdiam (double JD)
+{
+	struct ln_planet_geom geom;
+
+	ln_get_pluto_geom (JD, &geom);
+	return ln_get_pluto_geom_sdiam (&geom);
+}
+
+/*! \fn double ln_get_pluto_geom_sdiam (struct ln_planet_geom * geom)
+* \param geom Geometry of Pluto from ln_get_pluto_geom
+* \return Semidiameter in arc seconds
+*
+* Calculate the semidiameter of Pluto in arc seconds from its geometry.
+*/
+double ln_get_pluto_geom_sdiam (struct ln_planet_geom * geom)
 {
 	double So = 2.07; /* at 1 AU */
-	double dist;
-	
-	dist = ln_get_pluto_earth_dist (JD);
-	return So / dist;
+
+	return So / geom->delta;
 }
 	
 /*! \fn void ln_get_pluto_rect_helio (double JD, struct ln_rect_posn * position)
@@ -504,3 +501,59 @@ void ln_get_pluto_rect_helio (double JD, struct ln_rect_posn * position)
 	ln_get_pluto_helio_coords (JD, &pluto);
 	ln_get_rect_from_helio (&pluto, position);
 }
+
+/*! \fn void ln_get_pluto_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \param JD Julian day.
+* \param posn pointer to return position
+* \param vel pointer to return velocity
+*
+* Calculate Plutos rectangular heliocentric coordinates and velocity for the
+* given Julian day. Velocity is obtained by differentiating the periodic
+* terms. Coordinates are in AU, velocity in AU per day.
+*/
+void ln_get_pluto_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+{
+	struct ln_helio_posn position, rate;
+	double sum_longitude = 0, sum_latitude = 0, sum_radius = 0;
+	double dsum_longitude = 0, dsum_latitude = 0, dsum_radius = 0;
+	double J, S, P;
+	double t, a, da, sin_a, cos_a;
+	int i;
+
+	/* get julian centuries since J2000 */
+	t = (JD - 2451545) / 36525;
+
+	/* calculate mean longitudes for jupiter, saturn and pluto */
+	J =  34.35 + 3034.9057 * t;
+	S =  50.08 + 1222.1138 * t;
+	P = 238.96 +  144.9600 * t;
+
+	/* calc periodic terms in table 37.A and their rates per century */
+	for (i=0; i < PLUTO_COEFFS; i++) {
+		a = argument[i].J * J + argument[i].S * S + argument[i].P * P;
+		da = ln_deg_to_rad (argument[i].J * 3034.9057 +
+			argument[i].S * 1222.1138 + argument[i].P * 144.9600);
+		sin_a = sin (ln_deg_to_rad(a));
+		cos_a = cos (ln_deg_to_rad(a));
+
+		sum_longitude += longitude[i].A * sin_a + longitude[i].B * cos_a;
+		sum_latitude += latitude[i].A * sin_a + latitude[i].B * cos_a;
+		sum_radius += radius[i].A * sin_a + radius[i].B * cos_a;
+
+		dsum_longitude += (longitude[i].A * cos_a - longitude[i].B * sin_a) * da;
+		dsum_latitude += (latitude[i].A * cos_a - latitude[i].B * sin_a) * da;
+		dsum_radius += (radius[i].A * cos_a - radius[i].B * sin_a) * da;
+	}
+
+	/* calc L, B, R */
+	position.L = 238.958116 + 144.96 * t + sum_longitude * 0.000001;
+	position.B = -3.908239 + sum_latitude * 0.000001;
+	position.R = 40.7241346 + sum_radius * 0.0000001;
+
+	/* rates per day */
+	rate.L = (144.96 + dsum_longitude * 0.000001) / 36525;
+	rate.B = dsum_latitude * 0.000001 / 36525;
+	rate.R = dsum_radius * 0.0000001 / 36525;
+
+	ln_get_rect_state_from_helio (&position, &rate, posn, vel);
+}
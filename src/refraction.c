@@ -48,3 +48,234 @@ double ln_get_refraction_adj (double altitude, double atm_pres, double temp)
 	
 	return R;
 }
+
+/* Bennett refraction in arc minutes for apparent altitude, equ 16.4 */
+static double get_bennett (double apparent)
+{
+	double R;
+
+	R = 1.0 / tan (ln_deg_to_rad (apparent + 7.31 / (apparent + 4.4)));
+
+	/* zero at the zenith */
+	return R + 0.0013515;
+}
+
+/* Saemundsson refraction in arc minutes for true altitude, equ 16.3 */
+static double get_saemundsson (double altitude)
+{
+	double R;
+
+	R = 1.02 / tan (ln_deg_to_rad (altitude + 10.3 / (altitude + 5.11)));
+
+	/* zero at the zenith */
+	return R + 0.0019279;
+}
+
+/*! \fn double ln_get_refraction_bennett (double apparent, double atm_pres, double temp)
+* \param apparent Apparent altitude of the object in degrees
+* \param atm_pres Atmospheric pressure in milibars
+* \param temp Temperature in degrees C.
+* \return Refraction in degrees.
+*
+* Calculate atmospheric refraction for the apparent (observed) altitude of
+* a body by Bennett's formula. The true altitude is the apparent altitude
+* minus refraction. Accuracy is 0.07 arc minutes for all altitudes.
+*/
+double ln_get_refraction_bennett (double apparent, double atm_pres, double temp)
+{
+	return get_bennett (apparent) * (atm_pres / 1010) * (283 / (273 + temp)) / 60.0;
+}
+
+/*! \fn double ln_get_refraction_saemundsson (double altitude, double atm_pres, double temp)
+* \param altitude True (airless) altitude of the object in degrees
+* \param atm_pres Atmospheric pressure in milibars
+* \param temp Temperature in degrees C.
+* \return Refraction in degrees.
+*
+* Calculate atmospheric refraction for the true altitude of a body by
+* Saemundsson's formula. The apparent altitude is the true altitude plus
+* refraction. The formula is consistent with Bennett's formula to within
+* 4 arc seconds.
+*/
+double ln_get_refraction_saemundsson (double altitude, double atm_pres, double temp)
+{
+	return get_saemundsson (altitude) * (atm_pres / 1010) * (283 / (273 + temp)) / 60.0;
+}
+
+/*! \fn int ln_prep_refraction (int model, double atm_pres, double temp, double humidity, double wavelength, struct ln_refraction * refr)
+* \param model Refraction model, LN_REFRACTION_BENNETT or LN_REFRACTION_RIGOROUS
+* \param atm_pres Atmospheric pressure in milibars
+* \param temp Temperature in degrees C.
+* \param humidity Relative humidity, 0 to 1
+* \param wavelength Wavelength in micrometres
+* \param refr Pointer to store prepared refraction model
+* \return 0 on success, -1 on unknown model
+*
+* Prepare refraction model for given atmospheric conditions, used by
+* ln_get_apparent_alt, ln_get_true_alt and their batch versions.
+*
+* LN_REFRACTION_BENNETT uses Bennett's formula for apparent altitudes and
+* Saemundsson's formula for true altitudes, scaled by pressure and
+* temperature. Humidity and wavelength are ignored.
+*
+* LN_REFRACTION_RIGOROUS models refraction as A tan z + B tan^3 z of
+* zenith distance z, with A and B derived from pressure, temperature,
+* humidity and wavelength as in the refco function of the IAU SOFA
+* library. It is accurate to about 1 arc second above 15 degrees altitude,
+* but unsuitable close to the horizon. Wavelengths above 100 micrometres
+* are treated as radio.
+*/
+/* Green, Spherical Astronomy, 1987, pg 101-104 */
+int ln_prep_refraction (int model, double atm_pres, double temp, double humidity, double wavelength, struct ln_refraction * refr)
+{
+	double ps, pw, tk, wlsq, gamma, beta;
+	int optic;
+
+	refr->model = model;
+	refr->factor = (atm_pres / 1010) * (283 / (273 + temp)) / 60.0;
+	refr->A = 0;
+	refr->B = 0;
+
+	switch (model) {
+	case LN_REFRACTION_BENNETT:
+		return 0;
+	case LN_REFRACTION_RIGOROUS:
+		break;
+	default:
+		return -1;
+	}
+
+	/* keep conditions within sane limits */
+	temp = temp < -150.0 ? -150.0 : (temp > 200.0 ? 200.0 : temp);
+	atm_pres = atm_pres < 0 ? 0 : (atm_pres > 10000.0 ? 10000.0 : atm_pres);
+	humidity = humidity < 0 ? 0 : (humidity > 1.0 ? 1.0 : humidity);
+	wavelength = wavelength < 0.1 ? 0.1 : (wavelength > 1e6 ? 1e6 : wavelength);
+	optic = wavelength <= 100.0;
+
+	/* partial pressure of water vapour */
+	if (atm_pres > 0) {
+		ps = pow (10.0, (0.7859 + 0.03477 * temp) / (1.0 + 0.00412 * temp)) *
+			(1.0 + atm_pres * (4.5e-6 + 6e-10 * temp * temp));
+		pw = humidity * ps / (1.0 - (1.0 - humidity) * ps / atm_pres);
+	} else
+		pw = 0;
+
+	/* refractivity at the observer */
+	tk = temp + 273.15;
+	if (optic) {
+		wlsq = wavelength * wavelength;
+		gamma = ((77.53484e-6 + (4.39108e-7 + 3.666e-9 / wlsq) / wlsq) * atm_pres
+			- 11.2684e-6 * pw) / tk;
+	} else
+		gamma = (77.6890e-6 * atm_pres - (6.3938e-6 - 0.375463 / tk) * pw) / tk;
+
+	/* ratio of scale height of the atmosphere to radius of the Earth */
+	beta = 4.4474e-6 * tk;
+	if (!optic)
+		beta -= 0.0074 * pw * beta;
+
+	refr->A = gamma * (1.0 - beta);
+	refr->B = -gamma * (beta - gamma / 2.0);
+	return 0;
+}
+
+/* refraction of rigorous model in degrees for apparent altitude */
+static double get_rigorous (struct ln_refraction * refr, double apparent)
+{
+	double tz;
+
+	if (apparent < LN_REFRACTION_MIN_ALT)
+		apparent = LN_REFRACTION_MIN_ALT;
+	tz = 1.0 / tan (ln_deg_to_rad (apparent));
+
+	return ln_rad_to_deg ((refr->A + refr->B * tz * tz) * tz);
+}
+
+/* refraction of rigorous model in degrees for true altitude, by one
+ * Newton step from the true zenith distance, without iteration */
+static double get_rigorous_inv (struct ln_refraction * refr, double altitude)
+{
+	double s, c, tz, w;
+
+	if (altitude < LN_REFRACTION_MIN_ALT)
+		altitude = LN_REFRACTION_MIN_ALT;
+	s = sin (ln_deg_to_rad (altitude));
+	c = cos (ln_deg_to_rad (altitude));
+	tz = c / s;
+	w = refr->B * tz * tz;
+
+	return ln_rad_to_deg ((refr->A + w) * tz / (1.0 + (refr->A + 3.0 * w) / (s * s)));
+}
+
+/*! \fn double ln_get_apparent_alt (struct ln_refraction * refr, double altitude)
+* \param refr Refraction model from ln_prep_refraction
+* \param altitude True altitude in degrees
+* \return Apparent altitude in degrees.
+*
+* Calculate the apparent altitude of a body refracted by the atmosphere.
+*/
+double ln_get_apparent_alt (struct ln_refraction * refr, double altitude)
+{
+	if (refr->model == LN_REFRACTION_RIGOROUS)
+		return altitude + get_rigorous_inv (refr, altitude);
+	return altitude + get_saemundsson (altitude) * refr->factor;
+}
+
+/*! \fn double ln_get_true_alt (struct ln_refraction * refr, double apparent)
+* \param refr Refraction model from ln_prep_refraction
+* \param apparent Apparent altitude in degrees
+* \return True altitude in degrees.
+*
+* Calculate the true altitude of a body from its apparent altitude,
+* removing atmospheric refraction.
+*/
+double ln_get_true_alt (struct ln_refraction * refr, double apparent)
+{
+	if (refr->model == LN_REFRACTION_RIGOROUS)
+		return apparent - get_rigorous (refr, apparent);
+	return apparent - get_bennett (apparent) * refr->factor;
+}
+
+/*! \fn void ln_get_apparent_alt_batch (struct ln_refraction * refr, double * altitude, double * apparent, int count)
+* \param refr Refraction model from ln_prep_refraction
+* \param altitude Array of count true altitudes in degrees
+* \param apparent Array of count elements to store apparent altitudes
+* \param count Number of altitudes
+*
+* Calculate apparent altitudes for an array of true altitudes, as
+* ln_get_apparent_alt. The model is selected once for all altitudes.
+*/
+void ln_get_apparent_alt_batch (struct ln_refraction * refr, double * altitude, double * apparent, int count)
+{
+	int i;
+
+	if (refr->model == LN_REFRACTION_RIGOROUS) {
+		for (i = 0; i < count; i++)
+			apparent[i] = altitude[i] + get_rigorous_inv (refr, altitude[i]);
+	} else {
+		for (i = 0; i < count; i++)
+			apparent[i] = altitude[i] + get_saemundsson (altitude[i]) * refr->factor;
+	}
+}
+
+/*! \fn void ln_get_true_alt_batch (struct ln_refraction * refr, double * apparent, double * altitude, int count)
+* \param refr Refraction model from ln_prep_refraction
+* \param apparent Array of count apparent altitudes in degrees
+* \param altitude Array of count elements to store true altitudes
+* \param count Number of altitudes
+*
+* Calculate true altitudes for an array of apparent altitudes, as
+* ln_get_true_alt. The model is selected once for all altitudes.
+*/
+void ln_get_true_alt_batch (struct ln_refraction * refr, double * apparent, double * altitude, int count)
+{
+	int i;
+
+	if (refr->model == LN_REFRACTION_RIGOROUS) {
+		for (i = 0; i < count; i++)
+			altitude[i] = apparent[i] - get_rigorous (refr, apparent[i]);
+	} else {
+		for (i = 0; i < count; i++)
+			altitude[i] = apparent[i] - get_bennett (apparent[i]) * refr->factor;
+	}
+}
@@ -251,54 +251,21 @@ int ln_get_object_next_rst_horizon (double JD, struct ln_lnlat_posn *observer, s
 	return 0;
 }
 
-/*! \fn int ln_get_body_rst_horizon (double JD, struct ln_lnlat_posn *observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double horizon, struct ln_rst_time *rst); 
-* \param JD Julian day 
-* \param observer Observers position 
-* \param get_equ_body_coords Pointer to get_equ_body_coords() function
-* \param horizon Horizon, see LN_XXX_HORIZON constants
-* \param rst Pointer to store Rise, Set and Transit time in JD 
-* \return 0 for success, 1 for circumpolar (above the horizon), -1 for circumpolar (bellow the horizon)
-*
-* Calculate the time the rise, set and transit (crosses the local meridian at
-* upper culmination) time of the body for the given Julian day and given
-* horizon.
-*
-*
-* Note 1: this functions returns 1 if the object is circumpolar, that is it remains the whole
-* day above the horizon. Returns -1 when it remains whole day bellow the horizon.
-*
-* Note 2: this function will not work for body, which ra changes more
-* then 180 deg in one day (get_equ_body_coords changes so much). But
-* you should't use that function for any body which moves to fast..use
-* some special function for such things.
-*/
-int ln_get_body_rst_horizon (double JD, struct ln_lnlat_posn *observer,
-	void (*get_equ_body_coords) (double,struct ln_equ_posn *), double horizon,
-	struct ln_rst_time *rst)
+/* helper for ln_get_body_rst_horizon and friends - calculates rise, set
+ * and transit from body positions at JD_UT - 1, JD_UT and JD_UT + 1, where
+ * O is apparent sidereal time at JD_UT in degrees and T is the dynamical
+ * time difference in seconds */
+static int get_body_rst_samples (double JD_UT, double O, double T,
+	struct ln_lnlat_posn *observer, double horizon, struct ln_equ_posn *s1,
+	struct ln_equ_posn *s2, struct ln_equ_posn *s3, struct ln_rst_time *rst)
 {
-	int jd;
-	double T, O, JD_UT, H0, H1;
+	double H0, H1;
 	double Hat, Har, Has, altr, alts;
 	double mt, mr, ms, mst, msr, mss, nt, nr, ns;
-	struct ln_equ_posn sol1, sol2, sol3, post, posr, poss;
+	struct ln_equ_posn sol1 = *s1, sol2 = *s2, sol3 = *s3, post, posr, poss;
 	double dmt, dmr, dms;
 	int ret;
 
-	/* dynamical time diff */
-	T = ln_get_dynamical_time_diff (JD);
-
-	/* convert local sidereal time into degrees
-		 for 0h of UT on day JD */
-	jd = (int) JD;
-	JD_UT = jd + 0.5;
-	O = ln_get_apparent_sidereal_time (JD_UT);
-	O *= 15.0;
-
-	/* get body coords for JD_UT -1, JD_UT and JD_UT + 1 */
-	get_equ_body_coords (JD_UT - 1.0, &sol1);
-	get_equ_body_coords (JD_UT, &sol2);
-	get_equ_body_coords (JD_UT + 1.0, &sol3);
-
 	/* equ 15.1 */
 	H0 =
 		(sin (ln_deg_to_rad (horizon)) -
@@ -400,6 +367,171 @@ int ln_get_body_rst_horizon (double JD, struct ln_lnlat_posn *observer,
 	return 0;
 }
 
+/*! \fn int ln_get_body_rst_horizon (double JD, struct ln_lnlat_posn *observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double horizon, struct ln_rst_time *rst); 
+* \param JD Julian day 
+* \param observer Observers position 
+* \param get_equ_body_coords Pointer to get_equ_body_coords() function
+* \param horizon Horizon, see LN_XXX_HORIZON constants
+* \param rst Pointer to store Rise, Set and Transit time in JD 
+* \return 0 for success, 1 for circumpolar (above the horizon), -1 for circumpolar (bellow the horizon)
+*
+* Calculate the time the rise, set and transit (crosses the local meridian at
+* upper culmination) time of the body for the given Julian day and given
+* horizon.
+*
+*
+* Note 1: this functions returns 1 if the object is circumpolar, that is it remains the whole
+* day above the horizon. Returns -1 when it remains whole day bellow the horizon.
+*
+* Note 2: this function will not work for body, which ra changes more
+* then 180 deg in one day (get_equ_body_coords changes so much). But
+* you should't use that function for any body which moves to fast..use
+* some special function for such things.
+*/
+int ln_get_body_rst_horizon (double JD, struct ln_lnlat_posn *observer,
+	void (*get_equ_body_coords) (double,struct ln_equ_posn *), double horizon,
+	struct ln_rst_time *rst)
+{
+	int jd;
+	double T, O, JD_UT;
+	struct ln_equ_posn sol1, sol2, sol3;
+
+	/* dynamical time diff */
+	T = ln_get_dynamical_time_diff (JD);
+
+	/* convert local sidereal time into degrees
+		 for 0h of UT on day JD */
+	jd = (int) JD;
+	JD_UT = jd + 0.5;
+	O = ln_get_apparent_sidereal_time (JD_UT);
+	O *= 15.0;
+
+	/* get body coords for JD_UT -1, JD_UT and JD_UT + 1 */
+	get_equ_body_coords (JD_UT - 1.0, &sol1);
+	get_equ_body_coords (JD_UT, &sol2);
+	get_equ_body_coords (JD_UT + 1.0, &sol3);
+
+	return get_body_rst_samples (JD_UT, O, T, observer, horizon, &sol1, &sol2, &sol3, rst);
+}
+
+/*! \fn int ln_get_body_rst_horizon_table (double JD, int days, struct ln_lnlat_posn * observer, void (*get_equ_body_coords) (double, struct ln_equ_posn *), double horizon, struct ln_rst_time * rst, int * ret);
+* \param JD Julian day of the first day in the table
+* \param days Number of days in the table
+* \param observer Observers position
+* \param get_equ_body_coords Pointer to get_equ_body_coords() function
+* \param horizon Horizon, see LN_XXX_HORIZON constants
+* \param rst Array of days elements to store Rise, Set and Transit times in JD
+* \param ret Array of days elements to store ln_get_body_rst_horizon return
+* codes - 0 for success, 1 for circumpolar (above the horizon), -1 for circumpolar
+* (bellow the horizon)
+* \return Number of days on which the body rises and sets
+*
+* Calculate the rise, set and transit times of the body for days consecutive
+* days starting at Julian day JD. Entry i of rst and ret holds the same
+* values as ln_get_body_rst_horizon (JD + i, ...) would return.
+*
+* The body is evaluated once per day. Each day needs the body position at
+* 0h UT of the previous, the same and the next day, so the last two samples
+* are carried over to the next day instead of being calculated again. That
+* makes the table about three times cheaper then calling
+* ln_get_body_rst_horizon for every day, which is handy for almanacs.
+*
+* rst entries for circumpolar days are left untouched.
+*/
+int ln_get_body_rst_horizon_table (double JD, int days, struct ln_lnlat_posn * observer,
+	void (*get_equ_body_coords) (double, struct ln_equ_posn *), double horizon,
+	struct ln_rst_time * rst, int * ret)
+{
+	int jd, i, risen = 0;
+	double T, O, JD_UT;
+	struct ln_equ_posn sol[3];
+
+	if (days <= 0)
+		return 0;
+
+	jd = (int) JD;
+	JD_UT = jd + 0.5;
+
+	/* prime the window with positions for the day before and the first day */
+	get_equ_body_coords (JD_UT - 1.0, &sol[0]);
+	get_equ_body_coords (JD_UT, &sol[1]);
+
+	for (i = 0; i < days; i++) {
+		/* only the next day position is new */
+		get_equ_body_coords (JD_UT + i + 1.0, &sol[2]);
+
+		T = ln_get_dynamical_time_diff (JD + i);
+		O = ln_get_apparent_sidereal_time (JD_UT + i) * 15.0;
+
+		ret[i] = get_body_rst_samples (JD_UT + i, O, T, observer, horizon,
+			&sol[0], &sol[1], &sol[2], &rst[i]);
+		if (ret[i] == 0)
+			risen++;
+
+		/* roll the window */
+		sol[0] = sol[1];
+		sol[1] = sol[2];
+	}
+
+	return risen;
+}
+
+/*! \fn int ln_get_body_rst_horizon_observers (double JD, int count, struct ln_lnlat_posn * observers, double * horizons, void (*get_equ_body_coords) (double, struct ln_equ_posn *), struct ln_rst_time * rst, int * ret);
+* \param JD Julian day
+* \param count Number of observers
+* \param observers Array of count observers positions
+* \param horizons Array of count horizons, see LN_XXX_HORIZON constants
+* \param get_equ_body_coords Pointer to get_equ_body_coords() function
+* \param rst Array of count elements to store Rise, Set and Transit times in JD
+* \param ret Array of count elements to store return codes - 0 for success,
+* 1 for circumpolar (above the horizon), -1 for circumpolar (bellow the horizon)
+* \return Number of observers for which the body rises and sets
+*
+* Calculate the rise, set and transit times of the body for the given Julian
+* day for many observers at once. Entry i of rst and ret holds the same
+* values as ln_get_body_rst_horizon (JD, &observers[i], get_equ_body_coords,
+* horizons[i], ...) would return.
+*
+* The body positions, sidereal time and dynamical time difference depend only
+* on the day, so they are calculated once and shared by all observers.
+*
+* rst entries of circumpolar observers are left untouched.
+*/
+int ln_get_body_rst_horizon_observers (double JD, int count, struct ln_lnlat_posn * observers,
+	double * horizons, void (*get_equ_body_coords) (double, struct ln_equ_posn *),
+	struct ln_rst_time * rst, int * ret)
+{
+	int jd, i, risen = 0;
+	double T, O, JD_UT;
+	struct ln_equ_posn sol1, sol2, sol3;
+
+	if (count <= 0)
+		return 0;
+
+	/* dynamical time diff */
+	T = ln_get_dynamical_time_diff (JD);
+
+	/* sidereal time in degrees for 0h of UT on day JD */
+	jd = (int) JD;
+	JD_UT = jd + 0.5;
+	O = ln_get_apparent_sidereal_time (JD_UT);
+	O *= 15.0;
+
+	/* get body coords for JD_UT -1, JD_UT and JD_UT + 1 */
+	get_equ_body_coords (JD_UT - 1.0, &sol1);
+	get_equ_body_coords (JD_UT, &sol2);
+	get_equ_body_coords (JD_UT + 1.0, &sol3);
+
+	for (i = 0; i < count; i++) {
+		ret[i] = get_body_rst_samples (JD_UT, O, T, &observers[i], horizons[i],
+			&sol1, &sol2, &sol3, &rst[i]);
+		if (ret[i] == 0)
+			risen++;
+	}
+
+	return risen;
+}
+
 /*! \fn int ln_get_body_next_rst_horizon (double JD, struct ln_lnlat_posn * observer, struct ln_equ_posn * object, double horizon, struct ln_rst_time * rst);
 * \param JD Julian day 
 * \param observer Observers position 
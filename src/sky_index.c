@@ -0,0 +1,198 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <libnova/sky_index.h>
+#include <libnova/angular_separation.h>
+#include <libnova/utility.h>
+
+static int compare_ra (const void *a, const void *b)
+{
+	double ra1 = ((const struct ln_sky_entry *) a)->ra;
+	double ra2 = ((const struct ln_sky_entry *) b)->ra;
+
+	if (ra1 < ra2)
+		return -1;
+	return ra1 > ra2;
+}
+
+static int get_zone (struct ln_sky_index *index, double dec)
+{
+	int zone = (int) floor ((dec + 90.0) / index->zone_height);
+
+	if (zone < 0)
+		return 0;
+	if (zone >= index->zones)
+		return index->zones - 1;
+	return zone;
+}
+
+/* first entry of zone with right ascension not smaller than ra */
+static int find_ra (struct ln_sky_index *index, int zone, double ra)
+{
+	int lo = index->zone_start[zone], hi = index->zone_start[zone + 1], mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (index->entries[mid].ra < ra)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/* test entries of zone between right ascensions ra1 and ra2 */
+static int search_zone (struct ln_sky_index *index, int zone, double ra1,
+	double ra2, struct ln_equ_posn *centre, double radius, int *found,
+	int max_found, int count)
+{
+	struct ln_equ_posn posn;
+	int i, end = index->zone_start[zone + 1];
+
+	for (i = find_ra (index, zone, ra1); i < end; i++) {
+		if (index->entries[i].ra > ra2)
+			break;
+		posn.ra = index->entries[i].ra;
+		posn.dec = index->entries[i].dec;
+		if (ln_get_angular_separation (centre, &posn) > radius)
+			continue;
+		if (count < max_found)
+			found[count] = index->entries[i].index;
+		count++;
+	}
+	return count;
+}
+
+/*! \fn int ln_get_sky_index_zones (double zone_height);
+* \param zone_height Height of declination zone in degrees
+* \return Number of zones
+*
+* Calculate number of declination zones, i.e. the size of zone_start
+* buffer of ln_prep_sky_index minus one.
+*/
+int ln_get_sky_index_zones (double zone_height)
+{
+	return (int) ceil (180.0 / zone_height);
+}
+
+/*! \fn void ln_prep_sky_index (struct ln_equ_posn * posn, int count, double zone_height, int * zone_start, struct ln_sky_entry * entries, struct ln_sky_index * index);
+* \param posn Array of positions
+* \param count Number of positions
+* \param zone_height Height of declination zone in degrees, e.g. LN_SKY_INDEX_DEFAULT_ZONE
+* \param zone_start Buffer of ln_get_sky_index_zones (zone_height) + 1 integers
+* \param entries Buffer of count entries
+* \param index Pointer to store sky index, its arrays will point into the buffers
+*
+* Build sky index of positions. Positions are distributed to declination
+* zones by counting sort and then sorted by right ascension within each
+* zone. When the library is built with OpenMP, zones are sorted in
+* parallel. Zone height close to the typical search radius gives the
+* fastest searches.
+*/
+void ln_prep_sky_index (struct ln_equ_posn *posn, int count,
+	double zone_height, int *zone_start, struct ln_sky_entry *entries,
+	struct ln_sky_index *index)
+{
+	int i, zone, end = 0;
+
+	index->zone_height = zone_height;
+	index->zones = ln_get_sky_index_zones (zone_height);
+	index->zone_start = zone_start;
+	index->entries = entries;
+
+	/* zone_start holds end of each zone, which moves to its start as
+	 * entries are placed */
+	for (zone = 0; zone < index->zones; zone++)
+		zone_start[zone] = 0;
+	for (i = 0; i < count; i++)
+		zone_start[get_zone (index, posn[i].dec)]++;
+	for (zone = 0; zone < index->zones; zone++) {
+		end += zone_start[zone];
+		zone_start[zone] = end;
+	}
+	zone_start[index->zones] = count;
+
+	for (i = count - 1; i >= 0; i--) {
+		zone = get_zone (index, posn[i].dec);
+		zone_start[zone]--;
+		entries[zone_start[zone]].ra = ln_range_degrees (posn[i].ra);
+		entries[zone_start[zone]].dec = posn[i].dec;
+		entries[zone_start[zone]].index = i;
+	}
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for (zone = 0; zone < index->zones; zone++)
+		qsort (entries + zone_start[zone], zone_start[zone + 1] - zone_start[zone],
+			sizeof (struct ln_sky_entry), compare_ra);
+}
+
+/*! \fn int ln_get_sky_index_cone (struct ln_sky_index * index, struct ln_equ_posn * centre, double radius, int * found, int max_found);
+* \param index Sky index
+* \param centre Centre of cone
+* \param radius Radius of cone in degrees
+* \param found Array of max_found elements to store indices of positions
+* \param max_found Size of found array
+* \return Number of positions found. If it is greater than max_found, only
+* the first max_found indices were stored.
+*
+* Find all positions within radius of centre, i.e. positions for which
+* ln_get_angular_separation from centre is not greater than radius. Only
+* zones crossing the cone are searched, and within them only the range of
+* right ascension covered by the cone. Indices are not sorted.
+*/
+int ln_get_sky_index_cone (struct ln_sky_index *index,
+	struct ln_equ_posn *centre, double radius, int *found, int max_found)
+{
+	double ra, half;
+	int zone, last, count = 0;
+
+	zone = get_zone (index, centre->dec - radius);
+	last = get_zone (index, centre->dec + radius);
+
+	/* half width of cone in right ascension, whole circle near pole */
+	if (fabs (centre->dec) + radius >= 90.0 || radius >= 90.0)
+		half = 180.0;
+	else
+		half = ln_rad_to_deg (asin (sin (ln_deg_to_rad (radius)) /
+			cos (ln_deg_to_rad (centre->dec))));
+
+	ra = ln_range_degrees (centre->ra);
+
+	for (; zone <= last; zone++) {
+		if (half >= 180.0) {
+			count = search_zone (index, zone, 0, 360.0, centre, radius,
+				found, max_found, count);
+		} else if (ra - half < 0) {
+			count = search_zone (index, zone, 0, ra + half, centre, radius,
+				found, max_found, count);
+			count = search_zone (index, zone, ra - half + 360.0, 360.0,
+				centre, radius, found, max_found, count);
+		} else if (ra + half >= 360.0) {
+			count = search_zone (index, zone, ra - half, 360.0, centre,
+				radius, found, max_found, count);
+			count = search_zone (index, zone, 0, ra + half - 360.0, centre,
+				radius, found, max_found, count);
+		} else {
+			count = search_zone (index, zone, ra - half, ra + half, centre,
+				radius, found, max_found, count);
+		}
+	}
+	return count;
+}
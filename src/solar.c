@@ -22,6 +22,7 @@
 #include <libnova/earth.h>
 #include <libnova/nutation.h>
 #include <libnova/transform.h>
+#include <libnova/sidereal_time.h>
 #include <libnova/rise_set.h>
 #include <libnova/utility.h>
 
@@ -126,6 +127,28 @@ void ln_get_solar_geo_coords (double JD, struct ln_rect_posn * position)
 	position->Z *=-1.0;
 }
 
+/*! \fn void ln_get_solar_earth_state_equ_coords (struct ln_earth_state * earth, struct ln_equ_posn * position)
+* \param earth State of the Earth from ln_get_earth_state
+* \param position Pointer to store calculated solar position.
+*
+* Calculate apparent equatorial solar coordinates from state of the Earth,
+* with the same corrections as ln_get_solar_equ_coords but without
+* evaluating the VSOP87 series again.
+*/
+void ln_get_solar_earth_state_equ_coords (struct ln_earth_state * earth, struct ln_equ_posn * position)
+{
+	struct ln_lnlat_posn LB;
+
+	/* geometric coords with nutation and aberration */
+	LB.lng = ln_range_degrees (earth->helio.L + 180.0);
+	LB.lng += earth->nutation.longitude;
+	LB.lng -= (20.4898 / (360 * 60 * 60)) / earth->helio.R;
+	LB.lat = -earth->helio.B;
+
+	/* transform to equatorial */
+	ln_get_equ_from_ecl (&LB, earth->JD, position);
+}
+
 int ln_get_solar_rst_horizon (double JD, struct ln_lnlat_posn * observer, double horizon, struct ln_rst_time * rst)
 {
 	return ln_get_body_rst_horizon (JD, observer, ln_get_solar_equ_coords, horizon, rst);
@@ -157,6 +180,198 @@ double ln_get_solar_sdiam (double JD)
 	return So / dist;
 }
 
+/*! \fn void ln_get_solar_equ_coords_low (double JD, struct ln_equ_posn * position)
+* \param JD Julian day
+* \param position Pointer to store calculated solar position.
+*
+* Calculate apparent equatorial solar coordinates for given julian day
+* with the low accuracy formulae of Meeus. Accuracy is 0.01 degrees, which
+* is sufficient for solar energy and shading calculations, at a fraction
+* of the cost of ln_get_solar_equ_coords.
+*
+* Longitude is referred to the true equinox of date, whereas the VSOP87
+* longitude used by ln_get_solar_equ_coords is referred to the equinox
+* J2000.0. Results of the two functions therefore drift apart by general
+* precession, about 0.014 degrees per year from J2000.0.
+*/
+/* Chapter 25, pg 163-165 */
+void ln_get_solar_equ_coords_low (double JD, struct ln_equ_posn * position)
+{
+	double T, L0, M, C, omega, lambda, epsilon;
+
+	T = (JD - 2451545.0) / 36525.0;
+
+	/* geometric mean longitude and mean anomaly, 25.2 and 25.3 */
+	L0 = 280.46646 + T * (36000.76983 + T * 0.0003032);
+	M = ln_deg_to_rad (357.52911 + T * (35999.05029 - T * 0.0001537));
+
+	/* equation of centre */
+	C = (1.914602 - T * (0.004817 + T * 0.000014)) * sin (M)
+		+ (0.019993 - T * 0.000101) * sin (2 * M)
+		+ 0.000289 * sin (3 * M);
+
+	/* apparent longitude, corrected for nutation and aberration */
+	omega = ln_deg_to_rad (125.04 - 1934.136 * T);
+	lambda = ln_deg_to_rad (L0 + C - 0.00569 - 0.00478 * sin (omega));
+
+	/* apparent obliquity, 22.2 and 25.8 */
+	epsilon = 23.0 + 26.0 / 60.0 + 21.448 / 3600.0
+		- T * (46.8150 + T * (0.00059 - T * 0.001813)) / 3600.0;
+	epsilon = ln_deg_to_rad (epsilon + 0.00256 * cos (omega));
+
+	/* 25.6 and 25.7 */
+	position->ra = ln_range_degrees (ln_rad_to_deg (atan2 (cos (epsilon) * sin (lambda), cos (lambda))));
+	position->dec = ln_rad_to_deg (asin (sin (epsilon) * sin (lambda)));
+}
+
+/* sum of Chebyshev series at x in <-1, 1> by Clenshaw recurrence */
+static double get_cheb (double *c, int terms, double x)
+{
+	double b0 = 0, b1 = 0, b2;
+	int j;
+
+	for (j = terms - 1; j > 0; j--) {
+		b2 = b1;
+		b1 = b0;
+		b0 = 2 * x * b1 - b2 + c[j];
+	}
+	return x * b0 - b1 + c[0];
+}
+
+/*! \fn int ln_prep_solar_engine (int mode, double JD_start, double JD_end, int terms, struct ln_solar_engine * engine)
+* \param mode Method, one of LN_SOLAR_ENGINE_XXX
+* \param JD_start Start of time span in JD
+* \param JD_end End of time span in JD
+* \param terms Number of Chebyshev terms, up to LN_SOLAR_CHEB_TERMS
+* \param engine Pointer to store solar engine
+* \return 0 on success, -1 on invalid mode or number of terms
+*
+* Prepare solar position engine for ln_get_solar_engine_equ_coords and
+* ln_get_solar_engine_hrz_coords.
+*
+* LN_SOLAR_ENGINE_VSOP87 uses ln_get_solar_equ_coords, LN_SOLAR_ENGINE_LOW
+* uses ln_get_solar_equ_coords_low. Time span and terms are ignored by
+* these methods.
+*
+* LN_SOLAR_ENGINE_CHEB fits Chebyshev series to apparent coordinates
+* from ln_get_solar_equ_coords at terms nodes between JD_start and
+* JD_end. The series are evaluated in a few multiplications. With 8 terms
+* over one day, or 16 terms over 30 days, they reproduce the VSOP87
+* solution to better than 0.001 arc second. Outside the time span the
+* engine falls back to ln_get_solar_equ_coords.
+*/
+int ln_prep_solar_engine (int mode, double JD_start, double JD_end, int terms, struct ln_solar_engine * engine)
+{
+	struct ln_equ_posn equ;
+	double ra[LN_SOLAR_CHEB_TERMS], dec[LN_SOLAR_CHEB_TERMS];
+	double mid, half, f;
+	int j, k;
+
+	if (mode < LN_SOLAR_ENGINE_VSOP87 || mode > LN_SOLAR_ENGINE_CHEB)
+		return -1;
+
+	engine->mode = mode;
+	engine->JD_start = JD_start;
+	engine->JD_end = JD_end;
+	engine->terms = 0;
+
+	if (mode != LN_SOLAR_ENGINE_CHEB)
+		return 0;
+
+	if (terms < 1 || terms > LN_SOLAR_CHEB_TERMS || JD_end <= JD_start)
+		return -1;
+
+	mid = (JD_end + JD_start) / 2.0;
+	half = (JD_end - JD_start) / 2.0;
+
+	/* coordinates at Chebyshev nodes, right ascension made continuous */
+	for (k = 0; k < terms; k++) {
+		ln_get_solar_equ_coords (mid + half * cos (M_PI * (k + 0.5) / terms), &equ);
+		ra[k] = equ.ra;
+		dec[k] = equ.dec;
+		if (k > 0) {
+			while (ra[k] - ra[k - 1] > 180.0)
+				ra[k] -= 360.0;
+			while (ra[k] - ra[k - 1] < -180.0)
+				ra[k] += 360.0;
+		}
+	}
+
+	for (j = 0; j < terms; j++) {
+		engine->ra[j] = 0;
+		engine->dec[j] = 0;
+		for (k = 0; k < terms; k++) {
+			f = cos (M_PI * j * (k + 0.5) / terms);
+			engine->ra[j] += ra[k] * f;
+			engine->dec[j] += dec[k] * f;
+		}
+		engine->ra[j] *= 2.0 / terms;
+		engine->dec[j] *= 2.0 / terms;
+	}
+	engine->ra[0] /= 2.0;
+	engine->dec[0] /= 2.0;
+	engine->terms = terms;
+
+	return 0;
+}
+
+/*! \fn void ln_get_solar_engine_equ_coords (struct ln_solar_engine * engine, double JD, struct ln_equ_posn * position)
+* \param engine Solar engine from ln_prep_solar_engine
+* \param JD Julian day
+* \param position Pointer to store calculated solar position.
+*
+* Calculate apparent equatorial solar coordinates for given julian day
+* with the method of the solar engine.
+*/
+void ln_get_solar_engine_equ_coords (struct ln_solar_engine * engine, double JD, struct ln_equ_posn * position)
+{
+	double x;
+
+	switch (engine->mode) {
+	case LN_SOLAR_ENGINE_LOW:
+		ln_get_solar_equ_coords_low (JD, position);
+		return;
+	case LN_SOLAR_ENGINE_CHEB:
+		if (JD >= engine->JD_start && JD <= engine->JD_end) {
+			x = (2.0 * JD - engine->JD_start - engine->JD_end) /
+				(engine->JD_end - engine->JD_start);
+			position->ra = ln_range_degrees (get_cheb (engine->ra, engine->terms, x));
+			position->dec = get_cheb (engine->dec, engine->terms, x);
+			return;
+		}
+		break;
+	}
+	ln_get_solar_equ_coords (JD, position);
+}
+
+/*! \fn void ln_get_solar_engine_hrz_coords (struct ln_solar_engine * engine, double JD, struct ln_lnlat_posn * observers, int count, struct ln_hrz_posn * position)
+* \param engine Solar engine from ln_prep_solar_engine
+* \param JD Julian day
+* \param observers Array of count observer positions
+* \param count Number of observers
+* \param position Array of count horizontal positions to store
+*
+* Calculate horizontal solar coordinates for many observers at one
+* instant. Solar position and sidereal time are calculated once and
+* shared by all observers. Results are identical to calling
+* ln_get_hrz_from_equ with the solar engine position for every observer.
+*/
+void ln_get_solar_engine_hrz_coords (struct ln_solar_engine * engine, double JD, struct ln_lnlat_posn * observers, int count, struct ln_hrz_posn * position)
+{
+	struct ln_equ_posn equ;
+	double sidereal;
+	int i;
+
+	ln_get_solar_engine_equ_coords (engine, JD, &equ);
+	sidereal = ln_get_mean_sidereal_time (JD);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (i = 0; i < count; i++)
+		ln_get_hrz_from_equ_sidereal_time (&equ, observers + i, sidereal, position + i);
+}
+
 /*! \example sun.c
  * 
  * Examples of how to use solar functions. 
@@ -0,0 +1,149 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <math.h>
+#include <libnova/solar_system.h>
+#include <libnova/earth.h>
+#include <libnova/solar.h>
+#include <libnova/lunar.h>
+#include <libnova/mercury.h>
+#include <libnova/venus.h>
+#include <libnova/mars.h>
+#include <libnova/jupiter.h>
+#include <libnova/saturn.h>
+#include <libnova/uranus.h>
+#include <libnova/neptune.h>
+#include <libnova/pluto.h>
+#include <libnova/light_time.h>
+#include <libnova/transform.h>
+#include <libnova/utility.h>
+
+#define AU			149597870	/* km */
+
+/* planets in order of LN_BODY_XXX constants, with functions deriving
+ * magnitude and semidiameter from the planet geometry */
+static const struct planet {
+	void (*get_helio_state) (double JD, struct ln_rect_posn * posn,
+		struct ln_rect_posn * vel);
+	double (*get_magnitude) (struct ln_planet_geom * geom);
+	double (*get_sdiam) (struct ln_planet_geom * geom);
+} planets[LN_SOLAR_SYSTEM_BODIES - LN_BODY_MERCURY] = {
+	{ln_get_mercury_rect_helio_state, ln_get_mercury_geom_magnitude, ln_get_mercury_geom_sdiam},
+	{ln_get_venus_rect_helio_state, ln_get_venus_geom_magnitude, ln_get_venus_geom_sdiam},
+	{ln_get_mars_rect_helio_state, ln_get_mars_geom_magnitude, ln_get_mars_geom_sdiam},
+	{ln_get_jupiter_rect_helio_state, ln_get_jupiter_geom_magnitude, ln_get_jupiter_geom_equ_sdiam},
+	{ln_get_saturn_rect_helio_state, ln_get_saturn_geom_magnitude, ln_get_saturn_geom_equ_sdiam},
+	{ln_get_uranus_rect_helio_state, ln_get_uranus_geom_magnitude, ln_get_uranus_geom_sdiam},
+	{ln_get_neptune_rect_helio_state, ln_get_neptune_geom_magnitude, ln_get_neptune_geom_sdiam},
+	{ln_get_pluto_rect_helio_state, ln_get_pluto_geom_magnitude, ln_get_pluto_geom_sdiam},
+};
+
+static void get_planet (struct ln_earth_state *earth,
+	const struct planet *planet, struct ln_body_snapshot *body)
+{
+	struct ln_planet_geom geom;
+
+	ln_get_body_earth_state_geom (earth, planet->get_helio_state, &geom);
+	ln_get_equ_from_rect (&geom.geo, &body->equ);
+
+	body->earth_dist = geom.delta;
+	body->solar_dist = geom.r;
+	body->phase = geom.phase;
+	body->disk = ln_get_planet_geom_disk (&geom);
+	body->magnitude = planet->get_magnitude (&geom);
+	body->sdiam = planet->get_sdiam (&geom);
+}
+
+static void get_sun (struct ln_earth_state *earth,
+	struct ln_body_snapshot *body)
+{
+	ln_get_solar_earth_state_equ_coords (earth, &body->equ);
+	body->earth_dist = earth->helio.R;
+	body->solar_dist = 0;
+	body->magnitude = -26.74;
+	body->phase = 0;
+	body->disk = 1.0;
+	body->sdiam = 959.63 / earth->helio.R;
+}
+
+static void get_moon (struct ln_earth_state *earth,
+	struct ln_body_snapshot *body)
+{
+	struct ln_rect_posn moon;
+	struct ln_lnlat_posn ecl;
+	double delta, sun_lng, elong, R, i;
+
+	ln_get_lunar_geo_posn (earth->JD, &moon, 0);
+	delta = sqrt (moon.X * moon.X + moon.Y * moon.Y + moon.Z * moon.Z);
+
+	ecl.lng = ln_range_degrees (ln_rad_to_deg (atan2 (moon.Y, moon.X)));
+	ecl.lat = ln_rad_to_deg (atan2 (moon.Z, sqrt (moon.X * moon.X +
+		moon.Y * moon.Y)));
+	ln_get_equ_from_ecl (&ecl, earth->JD, &body->equ);
+
+	/* apparent solar longitude, as in ln_get_solar_ecl_coords */
+	sun_lng = earth->helio.L + 180.0 + earth->nutation.longitude -
+		(20.4898 / (360 * 60 * 60)) / earth->helio.R;
+
+	/* equ 48.2 and 48.3 */
+	elong = acos (cos (ln_deg_to_rad (ecl.lat)) *
+		cos (ln_deg_to_rad (sun_lng - ecl.lng)));
+	R = earth->helio.R * AU;
+	i = atan2 (R * sin (elong), delta - R * cos (elong));
+
+	body->earth_dist = delta / AU;
+	body->solar_dist = earth->helio.R;
+	body->phase = ln_rad_to_deg (i);
+	body->disk = (1.0 + cos (i)) / 2.0;
+	body->sdiam = 358473400 / delta;
+
+	/* Allen, Astrophysical Quantities */
+	i = body->phase;
+	body->magnitude = -12.73 + 0.026 * i + 4e-9 * i * i * i * i;
+}
+
+/*! \fn void ln_get_solar_system (double JD, struct ln_solar_system * system);
+* \param JD Julian day
+* \param system Pointer to store the snapshot
+*
+* Calculate equatorial coordinates, distances, visual magnitudes, phase
+* angles, illuminated fractions and semidiameters of the Sun, the Moon,
+* the planets and Pluto. The state of the Earth is calculated once and
+* stored in the snapshot, and the series of every other body are
+* evaluated once, the light time correction being extrapolated from the
+* body's velocity. When the library is built with OpenMP, the planets are
+* computed in parallel.
+*
+* Coordinates are the same as of ln_get_solar_equ_coords,
+* ln_get_lunar_equ_coords and ln_get_XXX_equ_coords. Distances,
+* magnitudes and phases of the planets refer to the light time corrected
+* position.
+*/
+void ln_get_solar_system (double JD, struct ln_solar_system * system)
+{
+	int i;
+
+	ln_get_earth_state (JD, &system->earth);
+	get_sun (&system->earth, &system->body[LN_BODY_SUN]);
+	get_moon (&system->earth, &system->body[LN_BODY_MOON]);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for (i = LN_BODY_MERCURY; i < LN_SOLAR_SYSTEM_BODIES; i++)
+		get_planet (&system->earth, &planets[i - LN_BODY_MERCURY],
+			&system->body[i]);
+}
@@ -245,6 +245,67 @@ void ln_get_ecl_from_equ (struct ln_equ_posn * object, double JD, struct ln_lnla
 	position->lng = ln_range_degrees(ln_rad_to_deg (longitude));
 }
 
+/*! \fn void ln_get_rect_state_from_helio (struct ln_helio_posn *object, struct ln_helio_posn *rate, struct ln_rect_posn * posn, struct ln_rect_posn * vel);
+* \param object Object heliocentric coordinates
+* \param rate Rate of change of object coordinates in degrees and AU per day
+* \param posn Pointer to store rectangular position
+* \param vel Pointer to store rectangular velocity in AU per day
+*
+* Transform an objects heliocentric ecliptical coordinates and their rate of
+* change into heliocentric rectangular position and velocity. Position is
+* the same as of ln_get_rect_from_helio.
+*/
+/* Equ 37.1 and its derivative
+*/
+void ln_get_rect_state_from_helio (struct ln_helio_posn *object,
+	struct ln_helio_posn *rate, struct ln_rect_posn * posn,
+	struct ln_rect_posn * vel)
+{
+	double sin_e, cos_e;
+	double cos_B, sin_B, sin_L, cos_L;
+	double dL, dB, x, y, z;
+
+	/* ecliptic J2000 */
+	sin_e = 0.397777156;
+	cos_e = 0.917482062;
+
+	cos_B = cos(ln_deg_to_rad(object->B));
+	cos_L = cos(ln_deg_to_rad(object->L));
+	sin_B = sin(ln_deg_to_rad(object->B));
+	sin_L = sin(ln_deg_to_rad(object->L));
+	dL = ln_deg_to_rad(rate->L) * object->R;
+	dB = ln_deg_to_rad(rate->B) * object->R;
+
+	ln_get_rect_from_helio (object, posn);
+
+	/* velocity in ecliptic frame, rotated as in equ 37.1 */
+	x = rate->R * cos_L * cos_B - dB * cos_L * sin_B - dL * sin_L * cos_B;
+	y = rate->R * sin_L * cos_B - dB * sin_L * sin_B + dL * cos_L * cos_B;
+	z = rate->R * sin_B + dB * cos_B;
+
+	vel->X = x;
+	vel->Y = y * cos_e - z * sin_e;
+	vel->Z = y * sin_e + z * cos_e;
+}
+
+/*! \fn void ln_get_equ_from_rect (struct ln_rect_posn * rect, struct ln_equ_posn * posn)
+* \param rect Rectangular equatorial coordinates.
+* \param posn Pointer to store new position.
+*
+* Transform an objects rectangular equatorial coordinates into equatorial
+* coordinates.
+*/
+/* Equ 33.10
+*/
+void ln_get_equ_from_rect (struct ln_rect_posn * rect, struct ln_equ_posn * posn)
+{
+	double t;
+
+	t = sqrt (rect->X * rect->X + rect->Y * rect->Y + rect->Z * rect->Z);
+	posn->ra = ln_range_degrees(ln_rad_to_deg (atan2 (rect->Y, rect->X)));
+	posn->dec = ln_rad_to_deg (asin (rect->Z / t));
+}
+
 /*! \fn void ln_get_ecl_from_rect (struct ln_rect_posn * rect, struct ln_lnlat_posn * posn)
 * \param rect Rectangular coordinates.
 * \param posn Pointer to store new position.
@@ -25,6 +25,7 @@
 #include <libnova/solar.h>
 #include <libnova/earth.h>
 #include <libnova/transform.h>
+#include <libnova/light_time.h>
 #include <libnova/rise_set.h>
 #include <libnova/utility.h>
 
@@ -5385,38 +5386,11 @@ static const struct ln_vsop uranus_radius_r4[RADIUS_R4] = {
 */ 
 void ln_get_uranus_equ_coords (double JD, struct ln_equ_posn * position)
 {
-	struct ln_helio_posn h_sol, h_uranus;
-	struct ln_rect_posn g_sol, g_uranus;
-	double a,b,c;
-	double ra, dec, delta, diff, last, t = 0;
-	
-	/* need typdef for solar heliocentric coords */
-	ln_get_solar_geom_coords (JD, &h_sol);
-	ln_get_rect_from_helio (&h_sol,  &g_sol);
-	
-	do {
-		last = t;
-		ln_get_uranus_helio_coords (JD - t, &h_uranus);
-		ln_get_rect_from_helio (&h_uranus, &g_uranus);
-
-		/* equ 33.10 pg 229 */
-		a = g_sol.X + g_uranus.X;
-		b = g_sol.Y + g_uranus.Y;
-		c = g_sol.Z + g_uranus.Z;
-	
-		delta = a*a + b*b + c*c;
-		delta = sqrt (delta);
-		t = delta * 0.0057755183;
-		diff = t - last;
-	} while (diff > 0.0001 || diff < -0.0001);
-		
-	ra = atan2 (b,a);
-	dec = c / delta;
-	dec = asin (dec);
+	struct ln_rect_posn g_uranus;
 
-	/* back to hours, degrees */
-	position->ra = ln_range_degrees(ln_rad_to_deg (ra));
-	position->dec = ln_rad_to_deg (dec);
+	/* light time corrected geocentric position, equ 33.10 pg 229 */
+	ln_get_body_light_time_geo_posn (JD, ln_get_uranus_rect_helio_state, &g_uranus);
+	ln_get_equ_from_rect (&g_uranus, position);
 }
 	
 
@@ -5543,6 +5517,32 @@ double ln_get_uranus_solar_dist (double JD)
 	return h_uranus.R;
 }
 	
+/*! \fn void ln_get_uranus_geom (double JD, struct ln_planet_geom * geom);
+* \param JD Julian day
+* \param geom Pointer to store geometry
+*
+* Calculate distances of Uranus from the Sun and the Earth and its phase
+* angle, corrected for light time. Magnitude, illuminated fraction and
+* semidiameter of Uranus are derived from the geometry.
+*/
+void ln_get_uranus_geom (double JD, struct ln_planet_geom * geom)
+{
+	ln_get_body_geom (JD, ln_get_uranus_rect_helio_state, geom);
+}
+
+/*! \fn double ln_get_uranus_geom_magnitude (struct ln_planet_geom * geom);
+* \param geom Geometry of Uranus from ln_get_uranus_geom
+* \return Visible magnitude of Uranus
+*
+* Calculate the visible magnitude of Uranus from its geometry.
+*/
+double ln_get_uranus_geom_magnitude (struct ln_planet_geom * geom)
+{
+	double r = geom->r, delta = geom->delta;
+
+	return -7.19 + 5 * log10 (r * delta);
+}
+
 /*! \fn double ln_get_uranus_magnitude (double JD);
 * \param JD Julian day
 * \brief Calculate the visible magnitude of Uranus
@@ -5553,13 +5553,10 @@ double ln_get_uranus_solar_dist (double JD)
 */ 
 double ln_get_uranus_magnitude (double JD)
 {
-	double delta, r;
-	
-	/* get distances */
-	r = ln_get_uranus_solar_dist (JD);
-	delta = ln_get_uranus_earth_dist (JD);
+	struct ln_planet_geom geom;
 
-	return -7.19 + 5 * log10 (r * delta);
+	ln_get_uranus_geom (JD, &geom);
+	return ln_get_uranus_geom_magnitude (&geom);
 }
 
 /*! \fn double ln_get_uranus_disk (double JD);
@@ -5573,15 +5570,10 @@ double ln_get_uranus_magnitude (double JD)
 /* Chapter 41 */
 double ln_get_uranus_disk (double JD)
 {
-	double r,delta,R;	
-	
-	/* get distances */
-	R = ln_get_earth_solar_dist (JD);
-	r = ln_get_uranus_solar_dist (JD);
-	delta = ln_get_uranus_earth_dist (JD);
-	
-	/* calc fraction angle */
-	return (((r + delta) * (r + delta)) - R * R) / (4 * r * delta);
+	struct ln_planet_geom geom;
+
+	ln_get_uranus_geom (JD, &geom);
+	return ln_get_planet_geom_disk (&geom);
 }
 
 /*! \fn double ln_get_uranus_phase (double JD);
@@ -5595,17 +5587,10 @@ double ln_get_uranus_disk (double JD)
 /* Chapter 41 */
 double ln_get_uranus_phase (double JD)
 {
-	double i,r,delta,R;	
-	
-	/* get distances */
-	R = ln_get_earth_solar_dist (JD);
-	r = ln_get_uranus_solar_dist (JD);
-	delta = ln_get_uranus_earth_dist (JD);
+	struct ln_planet_geom geom;
 
-	/* calc phase */
-	i = (r * r + delta * delta - R * R) / (2 * r * delta);
-	i = acos (i);
-	return ln_rad_to_deg (i);
+	ln_get_uranus_geom (JD, &geom);
+	return geom.phase;
 }
 
 /*! \fn double ln_get_uranus_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst_time * rst);
@@ -5634,12 +5619,24 @@ int ln_get_uranus_rst (double JD, struct ln_lnlat_posn * observer, struct ln_rst
 * given julian day.
 */
 double ln_get_uranus_sdiam (double JD)
+{
+	struct ln_planet_geom geom;
+
+	ln_get_uranus_geom (JD, &geom);
+	return ln_get_uranus_geom_sdiam (&geom);
+}
+
+/*! \fn double ln_get_uranus_geom_sdiam (struct ln_planet_geom * geom)
+* \param geom Geometry of Uranus from ln_get_uranus_geom
+* \return Semidiameter in arc seconds
+*
+* Calculate the semidiameter of Uranus in arc seconds from its geometry.
+*/
+double ln_get_uranus_geom_sdiam (struct ln_planet_geom * geom)
 {
 	double So = 35.02; /* at 1 AU */
-	double dist;
-	
-	dist = ln_get_uranus_earth_dist (JD);
-	return So / dist;
+
+	return So / geom->delta;
 }
 	
 /*! \fn void ln_get_uranus_rect_helio (double JD, struct ln_rect_posn * position)
@@ -5656,3 +5653,56 @@ void ln_get_uranus_rect_helio (double JD, struct ln_rect_posn * position)
 	ln_get_uranus_helio_coords (JD, &uranus);
 	ln_get_rect_from_helio (&uranus, position);
 }
+
+/*! \fn void ln_get_uranus_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \param JD Julian day.
+* \param posn pointer to return position
+* \param vel pointer to return velocity
+*
+* Calculate Uranus rectangular heliocentric coordinates and velocity for the
+* given Julian day. Velocity is obtained by differentiating the VSOP87
+* series term by term. Coordinates are in AU, velocity in AU per day.
+*/
+void ln_get_uranus_rect_helio_state (double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+{
+	double t;
+	double L[5], B[5], R[5];
+	double dL[5], dB[5], dR[5];
+	struct ln_helio_posn position, rate;
+
+	/* get julian ephemeris day */
+	t = (JD - 2451545.0) / 365250.0;
+
+	/* calc L series and derivatives */
+	L[0] = ln_calc_series_dot (uranus_longitude_l0, LONG_L0, t, &dL[0]);
+	L[1] = ln_calc_series_dot (uranus_longitude_l1, LONG_L1, t, &dL[1]);
+	L[2] = ln_calc_series_dot (uranus_longitude_l2, LONG_L2, t, &dL[2]);
+	L[3] = ln_calc_series_dot (uranus_longitude_l3, LONG_L3, t, &dL[3]);
+	L[4] = ln_calc_series_dot (uranus_longitude_l4, LONG_L4, t, &dL[4]);
+	position.L = ln_calc_series_poly (L, dL, 5, t, &rate.L);
+
+	/* calc B series and derivatives */
+	B[0] = ln_calc_series_dot (uranus_latitude_b0, LAT_B0, t, &dB[0]);
+	B[1] = ln_calc_series_dot (uranus_latitude_b1, LAT_B1, t, &dB[1]);
+	B[2] = ln_calc_series_dot (uranus_latitude_b2, LAT_B2, t, &dB[2]);
+	B[3] = ln_calc_series_dot (uranus_latitude_b3, LAT_B3, t, &dB[3]);
+	position.B = ln_calc_series_poly (B, dB, 4, t, &rate.B);
+
+	/* calc R series and derivatives */
+	R[0] = ln_calc_series_dot (uranus_radius_r0, RADIUS_R0, t, &dR[0]);
+	R[1] = ln_calc_series_dot (uranus_radius_r1, RADIUS_R1, t, &dR[1]);
+	R[2] = ln_calc_series_dot (uranus_radius_r2, RADIUS_R2, t, &dR[2]);
+	R[3] = ln_calc_series_dot (uranus_radius_r3, RADIUS_R3, t, &dR[3]);
+	R[4] = ln_calc_series_dot (uranus_radius_r4, RADIUS_R4, t, &dR[4]);
+	position.R = ln_calc_series_poly (R, dR, 5, t, &rate.R);
+
+	/* change to degrees in correct quadrant, rates to degrees per day */
+	position.L = ln_range_degrees(ln_rad_to_deg(position.L));
+	position.B = ln_rad_to_deg(position.B);
+	rate.L = ln_rad_to_deg(rate.L) / 365250.0;
+	rate.B = ln_rad_to_deg(rate.B) / 365250.0;
+	rate.R /= 365250.0;
+
+	/* change to fk5 reference frame and rectangular coordinates */
+	ln_vsop87_rect_state (&position, &rate, JD, posn, vel);
+}
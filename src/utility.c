@@ -428,7 +428,7 @@ double ln_get_rect_distance (struct ln_rect_posn * a, struct ln_rect_posn * b)
 */
 double ln_get_light_time (double dist)
 {
-	return dist * 0.005775183;
+	return dist * 0.0057755183;
 }
 
 
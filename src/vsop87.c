@@ -22,6 +22,7 @@
 
 #include <math.h>
 #include <libnova/vsop87.h>
+#include <libnova/transform.h>
 #include <libnova/utility.h>
 
 double ln_calc_series (const struct ln_vsop * data, int terms, double t)
@@ -37,6 +38,79 @@ double ln_calc_series (const struct ln_vsop * data, int terms, double t)
 	return value;
 }
 
+/* value and derivative per unit of t of the series, in one pass */
+double ln_calc_series_dot (const struct ln_vsop * data, int terms, double t,
+	double * dot)
+{
+	double value = 0, arg;
+	int i;
+
+	*dot = 0;
+	for (i=0; i<terms; i++) {
+		arg = data->B + data->C * t;
+		value += data->A * cos(arg);
+		*dot -= data->A * data->C * sin(arg);
+		data++;
+	}
+
+	return value;
+}
+
+/* sum of series[k] * t^k and its derivative, series_dot[k] being
+   derivatives of the series */
+double ln_calc_series_poly (const double * series, const double * series_dot,
+	int n, double t, double * dot)
+{
+	double value;
+	int k;
+
+	value = series[n - 1];
+	*dot = series_dot[n - 1];
+	for (k = n - 2; k >= 0; k--) {
+		*dot = *dot * t + value + series_dot[k];
+		value = value * t + series[k];
+	}
+
+	return value;
+}
+
+/*! \fn void ln_vsop87_rect_state (struct ln_helio_posn * position, struct ln_helio_posn * rate, double JD, struct ln_rect_posn * posn, struct ln_rect_posn * vel)
+* \param position Heliocentric ecliptical position in VSOP87 frame
+* \param rate Rate of change of position in degrees and AU per day
+* \param JD Julian day
+* \param posn Pointer to store rectangular position
+* \param vel Pointer to store rectangular velocity in AU per day
+*
+* Transform heliocentric ecliptical position and its rate of change in
+* VSOP87 frame to FK5 rectangular equatorial position and velocity.
+* Position is the same as of ln_vsop87_to_fk5 followed by
+* ln_get_rect_from_helio.
+*/
+void ln_vsop87_rect_state (struct ln_helio_posn * position,
+	struct ln_helio_posn * rate, double JD, struct ln_rect_posn * posn,
+	struct ln_rect_posn * vel)
+{
+	struct ln_helio_posn fk5, fk5_rate;
+	double T, B, LL, cos_LL, sin_LL, dLL, dB;
+
+	/* derivative of equ 31.3, in degrees per day */
+	T = (JD - 2451545.0) / 36525.0;
+	LL = ln_deg_to_rad (position->L + ( - 1.397 - 0.00031 * T ) * T);
+	cos_LL = cos(LL);
+	sin_LL = sin(LL);
+	B = ln_deg_to_rad(position->B);
+	dLL = ln_deg_to_rad (rate->L - (1.397 + 0.00062 * T) / 36525.0);
+	dB = ln_deg_to_rad (rate->B);
+
+	fk5_rate.L = rate->L + (0.03916 / 3600.0) * ((cos_LL - sin_LL) * tan (B) * dLL
+		+ (cos_LL + sin_LL) * dB / (cos (B) * cos (B)));
+	fk5_rate.B = rate->B - (0.03916 / 3600.0) * (sin_LL + cos_LL) * dLL;
+	fk5_rate.R = rate->R;
+
+	fk5 = *position;
+	ln_vsop87_to_fk5 (&fk5, JD);
+	ln_get_rect_state_from_helio (&fk5, &fk5_rate, posn, vel);
+}
 
 /*! \fn void ln_vsop87_to_fk5 (struct ln_helio_posn * position, double JD)
 * \param position Position to transform. 